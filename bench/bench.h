@@ -0,0 +1,87 @@
+/* SNCL Bench v1.00
+   Tiny helpers shared by the benchmark executables in this folder (not part of the library).
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_BENCH_H__
+#define SNCL_BENCH_H__
+
+#if !defined(_POSIX_C_SOURCE) && defined(__unix__)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+// Thread counts every scaling benchmark is run at, `0` stands for the number of online CPUs.
+static const size_t bench_thread_counts[] = {1, 2, 4, 8, 0};
+#define BENCH_THREAD_COUNTS (sizeof(bench_thread_counts) / sizeof(bench_thread_counts[0]))
+
+// Keeps the optimizer from throwing away results the benchmark never reads.
+static volatile uint64_t bench_sink;
+
+// Returns a monotonic timestamp in seconds.
+static inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Returns the number of online CPUs (at least 1).
+static inline size_t bench_cpus(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t)n : 1;
+}
+
+// Resolves an entry of `bench_thread_counts`, returns `0` if it repeats the CPU count and should be skipped.
+static inline size_t bench_threads(size_t i) {
+    size_t t = bench_thread_counts[i];
+    if (t == 0) {
+        t = bench_cpus();
+        for (size_t j = 0; j + 1 < BENCH_THREAD_COUNTS; j++) {
+            if (bench_thread_counts[j] == t)
+                return 0;
+        }
+    }
+    return t;
+}
+
+// Reads the workload scale from `argv[1]`, so `bench_x 10` runs ten times the default work. Defaults to 1.
+static inline size_t bench_scale(int argc, char **argv) {
+    if (argc < 2)
+        return 1;
+    long s = strtol(argv[1], NULL, 10);
+    return s > 0 ? (size_t)s : 1;
+}
+
+// Prints one result row, `ops` is the amount of work done in `seconds` (used for the ns/op column).
+static inline void bench_report(const char *name, size_t threads, double seconds, double ops) {
+    printf("%-44s %3zu thr %10.3f ms %10.2f ns/op\n", name, threads, seconds * 1e3, seconds * 1e9 / ops);
+}
+
+// Runs `fn(arg + i * arg_size)` on `threads` threads at once and returns the wall time in seconds.
+static inline double bench_run_threads(size_t threads, void *(*fn)(void *), void *args, size_t arg_size) {
+    pthread_t *tids = malloc(threads * sizeof(pthread_t));
+    if (!tids)
+        abort();
+
+    double start = bench_now();
+    for (size_t i = 0; i < threads; i++) {
+        if (pthread_create(&tids[i], NULL, fn, (char *)args + i * arg_size) != 0)
+            abort();
+    }
+    for (size_t i = 0; i < threads; i++)
+        pthread_join(tids[i], NULL);
+    double elapsed = bench_now() - start;
+
+    free(tids);
+    return elapsed;
+}
+
+#endif // SNCL_BENCH_H__
@@ -0,0 +1,96 @@
+#include "bench.h"
+
+#include <sncl_arena.h>
+#include <sncl_arraylist.h>
+
+#define ROUNDS 200
+#define ALLOCS_PER_ROUND 4096
+#define LISTS_PER_ROUND 64
+
+typedef struct {
+    size_t rounds;
+    int use_arena;
+} churn_arg_t;
+
+// Allocates a round worth of small, odd-sized blocks and releases them all, like a per-request scratch buffer would
+static void *alloc_churn(void *p) {
+    churn_arg_t *a = p;
+    void **ptrs = malloc(ALLOCS_PER_ROUND * sizeof(void *));
+    sncl_arena_t *arena = a->use_arena ? sncl_arena_create(0) : NULL;
+    uint64_t sum = 0;
+
+    for (size_t r = 0; r < a->rounds; r++) {
+        for (size_t i = 0; i < ALLOCS_PER_ROUND; i++) {
+            size_t size = 16 + (i * 37) % 240;
+            char *q = arena ? sncl_arena_alloc(arena, size) : malloc(size);
+            q[0] = (char)i;
+            sum += (uint64_t)q[0];
+            ptrs[i] = q;
+        }
+        if (arena) {
+            sncl_arena_reset(arena);
+        } else {
+            for (size_t i = 0; i < ALLOCS_PER_ROUND; i++)
+                free(ptrs[i]);
+        }
+    }
+
+    if (arena)
+        sncl_arena_destroy(arena);
+    free(ptrs);
+    bench_sink += sum;
+    return NULL;
+}
+
+// Builds and drops a batch of growing ArrayLists per round, through the heap or through a per-thread arena
+static void *list_churn(void *p) {
+    churn_arg_t *a = p;
+    sncl_arena_t *arena = a->use_arena ? sncl_arena_create(0) : NULL;
+    int *lists[LISTS_PER_ROUND];
+    uint64_t sum = 0;
+
+    for (size_t r = 0; r < a->rounds; r++) {
+        for (size_t l = 0; l < LISTS_PER_ROUND; l++) {
+            lists[l] = arena ? array_list_new_with(int, sncl_arena_allocator(arena)) : array_list_new(int);
+            for (int i = 0; i < 100; i++)
+                array_list_push_back(lists[l], i);
+            sum += (uint64_t)array_list_size(lists[l]);
+        }
+        if (arena) {
+            sncl_arena_reset(arena);
+        } else {
+            for (size_t l = 0; l < LISTS_PER_ROUND; l++)
+                array_list_destroy(lists[l]);
+        }
+    }
+
+    if (arena)
+        sncl_arena_destroy(arena);
+    bench_sink += sum;
+    return NULL;
+}
+
+static void run(const char *name, void *(*fn)(void *), int use_arena, size_t rounds, double ops_per_round) {
+    for (size_t i = 0; i < BENCH_THREAD_COUNTS; i++) {
+        size_t t = bench_threads(i);
+        if (!t)
+            continue;
+
+        churn_arg_t *args = malloc(t * sizeof(churn_arg_t));
+        for (size_t j = 0; j < t; j++)
+            args[j] = (churn_arg_t){rounds, use_arena};
+        double s = bench_run_threads(t, fn, args, sizeof(churn_arg_t));
+        bench_report(name, t, s, (double)t * (double)rounds * ops_per_round);
+        free(args);
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t rounds = ROUNDS * bench_scale(argc, argv);
+
+    run("alloc churn: malloc/free", alloc_churn, 0, rounds, ALLOCS_PER_ROUND);
+    run("alloc churn: arena alloc/reset", alloc_churn, 1, rounds, ALLOCS_PER_ROUND);
+    run("arraylist churn: heap", list_churn, 0, rounds, LISTS_PER_ROUND * 100.0);
+    run("arraylist churn: arena allocator", list_churn, 1, rounds, LISTS_PER_ROUND * 100.0);
+    return 0;
+}
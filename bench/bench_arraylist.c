@@ -0,0 +1,82 @@
+#include "bench.h"
+
+#include <sncl_arraylist.h>
+
+#define ELEMENTS (1u << 22)
+#define REPEATS 10
+
+SNCL_ARRAYLIST_DEFINE(int, intlist)
+
+// Pushes, sums and pops `n` ints `REPEATS` times through the generic macros and through the typed functions
+int main(int argc, char **argv) {
+    size_t n = ELEMENTS * bench_scale(argc, argv);
+    double s, ops = (double)n * REPEATS;
+    uint64_t sum;
+
+    s = bench_now();
+    for (size_t r = 0; r < REPEATS; r++) {
+        int *list = array_list_new(int);
+        for (size_t i = 0; i < n; i++) {
+            int v = (int)i;
+            array_list_push_back(list, v);
+        }
+        bench_sink += array_list_size(list);
+        array_list_destroy(list);
+    }
+    bench_report("push_back: generic", 1, bench_now() - s, ops);
+
+    s = bench_now();
+    for (size_t r = 0; r < REPEATS; r++) {
+        int *list = intlist_new();
+        for (size_t i = 0; i < n; i++)
+            intlist_push_back(&list, (int)i);
+        bench_sink += intlist_size(list);
+        intlist_destroy(list);
+    }
+    bench_report("push_back: SNCL_ARRAYLIST_DEFINE", 1, bench_now() - s, ops);
+
+    int *list = intlist_new_with_capacity(n);
+    for (size_t i = 0; i < n; i++)
+        intlist_push_back(&list, (int)i);
+
+    s = bench_now();
+    sum = 0;
+    for (size_t r = 0; r < REPEATS; r++) {
+        for (size_t i = 0; i < array_list_size(list); i++)
+            sum += (uint64_t)array_list_at(list, i);
+    }
+    bench_sink += sum;
+    bench_report("indexed read: generic", 1, bench_now() - s, ops);
+
+    s = bench_now();
+    sum = 0;
+    for (size_t r = 0; r < REPEATS; r++) {
+        for (size_t i = 0; i < intlist_size(list); i++)
+            sum += (uint64_t)intlist_at(list, i);
+    }
+    bench_sink += sum;
+    bench_report("indexed read: SNCL_ARRAYLIST_DEFINE", 1, bench_now() - s, ops);
+
+    s = bench_now();
+    for (size_t r = 0; r < REPEATS; r++) {
+        while (!array_list_empty(list)) {
+            int v = array_list_pop_back(list);
+            bench_sink += (uint64_t)v;
+        }
+        for (size_t i = 0; i < n; i++)
+            intlist_push_back(&list, (int)i);
+    }
+    bench_report("pop_back + refill: generic", 1, bench_now() - s, ops * 2);
+
+    s = bench_now();
+    for (size_t r = 0; r < REPEATS; r++) {
+        while (!intlist_empty(list))
+            bench_sink += (uint64_t)intlist_pop_back(list);
+        for (size_t i = 0; i < n; i++)
+            intlist_push_back(&list, (int)i);
+    }
+    bench_report("pop_back + refill: SNCL_ARRAYLIST_DEFINE", 1, bench_now() - s, ops * 2);
+
+    intlist_destroy(list);
+    return 0;
+}
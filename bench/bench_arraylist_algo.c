@@ -0,0 +1,150 @@
+#include "bench.h"
+
+#include <string.h>
+
+#include <sncl_arraylist_algo.h>
+
+#define ELEMENTS (1u << 20)
+#define REPEATS 50
+
+// The scalar baselines go through memcmp per element, the way a generic find over an arbitrary type is written
+static void *scalar_find(void *list, const void *value) {
+    size_t size = array_list_type_size(list);
+    char *p = array_list_vbegin(list), *end = array_list_vend(list);
+    for (; p != end; p += size) {
+        if (memcmp(p, value, size) == 0)
+            return p;
+    }
+    return end;
+}
+
+static size_t scalar_count(void *list, const void *value) {
+    size_t size = array_list_type_size(list), count = 0;
+    char *p = array_list_vbegin(list), *end = array_list_vend(list);
+    for (; p != end; p += size)
+        count += memcmp(p, value, size) == 0;
+    return count;
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Sorts the same shuffled input `repeats` times (qsort, radix or parallel merge on `threads`), timing only the sorts
+static void bench_sort(const char *name, size_t n, size_t repeats, size_t threads, int radix) {
+    uint32_t *list = array_list_new_with_capacity(uint32_t, n);
+    double total = 0;
+
+    for (size_t r = 0; r < repeats; r++) {
+        array_list_clear(list);
+        uint32_t state = 12345;
+        for (size_t i = 0; i < n; i++) {
+            state = state * 1664525u + 1013904223u;
+            array_list_push_back(list, state);
+        }
+
+        double s = bench_now();
+        if (radix)
+            array_list_sort_radix(list, ARRAY_LIST_U32);
+        else if (threads)
+            array_list_sort_parallel(list, cmp_u32, threads);
+        else
+            qsort(list, n, sizeof(uint32_t), cmp_u32);
+        total += bench_now() - s;
+        bench_sink += list[n / 2];
+    }
+
+    bench_report(name, threads ? threads : 1, total, (double)n * repeats);
+    array_list_destroy(list);
+}
+
+#define BENCH_KIND(type, kind, label)                                                                                 \
+    do {                                                                                                              \
+        type *list = array_list_new_with_capacity(type, n);                                                           \
+        for (size_t i = 0; i < n; i++) {                                                                              \
+            type v = (type)(i % 97);                                                                                  \
+            array_list_push_back(list, v);                                                                            \
+        }                                                                                                             \
+        type missing = (type)100, needle = (type)42;                                                                  \
+        double s;                                                                                                     \
+                                                                                                                      \
+        s = bench_now();                                                                                              \
+        for (size_t r = 0; r < REPEATS; r++) bench_sink += (uint64_t)(array_list_vfind(list, &missing) != NULL);      \
+        bench_report("find " label ": simd", 1, bench_now() - s, (double)n * REPEATS);                                \
+        s = bench_now();                                                                                              \
+        for (size_t r = 0; r < REPEATS; r++) bench_sink += (uint64_t)(scalar_find(list, &missing) != NULL);          \
+        bench_report("find " label ": memcmp loop", 1, bench_now() - s, (double)n * REPEATS);                         \
+                                                                                                                      \
+        s = bench_now();                                                                                              \
+        for (size_t r = 0; r < REPEATS; r++) bench_sink += array_list_vcount(list, &needle);                          \
+        bench_report("count " label ": simd", 1, bench_now() - s, (double)n * REPEATS);                               \
+        s = bench_now();                                                                                              \
+        for (size_t r = 0; r < REPEATS; r++) bench_sink += scalar_count(list, &needle);                               \
+        bench_report("count " label ": memcmp loop", 1, bench_now() - s, (double)n * REPEATS);                        \
+                                                                                                                      \
+        s = bench_now();                                                                                              \
+        for (size_t r = 0; r < REPEATS; r++) {                                                                        \
+            type min, max;                                                                                            \
+            array_list_vmin_max(list, kind, &min, &max);                                                              \
+            bench_sink += (uint64_t)(max - min);                                                                      \
+        }                                                                                                             \
+        bench_report("min/max " label ": simd", 1, bench_now() - s, (double)n * REPEATS);                             \
+        s = bench_now();                                                                                              \
+        for (size_t r = 0; r < REPEATS; r++) {                                                                        \
+            type min = list[0], max = list[0];                                                                        \
+            for (size_t i = 1; i < n; i++) {                                                                          \
+                if (list[i] < min) min = list[i];                                                                     \
+                if (list[i] > max) max = list[i];                                                                     \
+            }                                                                                                         \
+            bench_sink += (uint64_t)(max - min);                                                                      \
+        }                                                                                                             \
+        bench_report("min/max " label ": scalar loop", 1, bench_now() - s, (double)n * REPEATS);                      \
+                                                                                                                      \
+        array_list_destroy(list);                                                                                     \
+    } while (0)
+
+int main(int argc, char **argv) {
+    size_t n = ELEMENTS * bench_scale(argc, argv);
+
+    BENCH_KIND(uint8_t, ARRAY_LIST_U8, "u8");
+    BENCH_KIND(int32_t, ARRAY_LIST_I32, "i32");
+    BENCH_KIND(int64_t, ARRAY_LIST_I64, "i64");
+    BENCH_KIND(double, ARRAY_LIST_F64, "f64");
+
+    double *list = array_list_new_with_capacity(double, n);
+    for (size_t i = 0; i < n; i++) {
+        double v = (double)(i % 1000) * 0.5;
+        array_list_push_back(list, v);
+    }
+    double s = bench_now();
+    for (size_t r = 0; r < REPEATS; r++) {
+        double sum;
+        array_list_vsum(list, ARRAY_LIST_F64, &sum);
+        bench_sink += (uint64_t)sum;
+    }
+    bench_report("sum f64: simd", 1, bench_now() - s, (double)n * REPEATS);
+    s = bench_now();
+    for (size_t r = 0; r < REPEATS; r++) {
+        double sum = 0;
+        for (size_t i = 0; i < n; i++)
+            sum += list[i];
+        bench_sink += (uint64_t)sum;
+    }
+    bench_report("sum f64: scalar loop", 1, bench_now() - s, (double)n * REPEATS);
+    array_list_destroy(list);
+
+    // a large sort, then many mid-sized ones where thread start-up used to dominate
+    size_t sizes[] = {n * 4, 65536}, repeats[] = {3, 50};
+    for (size_t k = 0; k < 2; k++) {
+        printf("sorting %zu u32 elements\n", sizes[k]);
+        bench_sort("sort: qsort", sizes[k], repeats[k], 0, 0);
+        bench_sort("sort: radix", sizes[k], repeats[k], 0, 1);
+        for (size_t i = 0; i < BENCH_THREAD_COUNTS; i++) {
+            size_t t = bench_threads(i);
+            if (t)
+                bench_sort("sort: parallel merge", sizes[k], repeats[k], t, 0);
+        }
+    }
+    return 0;
+}
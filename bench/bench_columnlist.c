@@ -0,0 +1,85 @@
+#include "bench.h"
+
+#include <sncl_arraylist.h>
+#include <sncl_columnlist.h>
+
+#define ROWS (1u << 21)
+#define REPEATS 20
+
+// A record where the hot loops only ever read one or two fields
+typedef struct {
+    uint64_t id;
+    double price;
+    int32_t quantity;
+    int32_t flags;
+    char name[40];
+} row_t;
+
+static row_t make_row(size_t i) {
+    row_t r = { (uint64_t)i, (double)(i % 1000) * 0.25, (int32_t)(i % 97), 0, { 0 } };
+    r.name[0] = (char)('a' + i % 26);
+    return r;
+}
+
+// Sums `price` (and `price * quantity`) over `n` rows `REPEATS` times, as whole structs and as columns
+int main(int argc, char **argv) {
+    size_t n = ROWS * bench_scale(argc, argv);
+    double s, ops = (double)n * REPEATS;
+
+    array_list(row_t) rows = array_list_new(row_t);
+    column_list(row_t) cols =
+        column_list_new(row_t, COLUMN_LIST_FIELD(row_t, id), COLUMN_LIST_FIELD(row_t, price),
+                        COLUMN_LIST_FIELD(row_t, quantity), COLUMN_LIST_FIELD(row_t, flags),
+                        COLUMN_LIST_FIELD(row_t, name));
+
+    s = bench_now();
+    for (size_t i = 0; i < n; i++) {
+        row_t r = make_row(i);
+        array_list_push_back(rows, r);
+    }
+    bench_report("push rows: arraylist (AoS)", 1, bench_now() - s, (double)n);
+
+    s = bench_now();
+    for (size_t i = 0; i < n; i++) {
+        row_t r = make_row(i);
+        column_list_push_row(cols, r);
+    }
+    bench_report("push rows: column list (SoA)", 1, bench_now() - s, (double)n);
+
+    double sum = 0;
+    s = bench_now();
+    for (size_t r = 0; r < REPEATS; r++) {
+        for (size_t i = 0; i < n; i++)
+            sum += rows[i].price;
+    }
+    bench_report("sum price: arraylist (AoS)", 1, bench_now() - s, ops);
+
+    s = bench_now();
+    for (size_t r = 0; r < REPEATS; r++) {
+        const double *price = column_list_column_as(cols, 1, double);
+        for (size_t i = 0; i < n; i++)
+            sum += price[i];
+    }
+    bench_report("sum price: column list (SoA)", 1, bench_now() - s, ops);
+
+    s = bench_now();
+    for (size_t r = 0; r < REPEATS; r++) {
+        for (size_t i = 0; i < n; i++)
+            sum += rows[i].price * rows[i].quantity;
+    }
+    bench_report("sum price * quantity: arraylist (AoS)", 1, bench_now() - s, ops);
+
+    s = bench_now();
+    for (size_t r = 0; r < REPEATS; r++) {
+        const double *price = column_list_column_as(cols, 1, double);
+        const int32_t *quantity = column_list_column_as(cols, 2, int32_t);
+        for (size_t i = 0; i < n; i++)
+            sum += price[i] * quantity[i];
+    }
+    bench_report("sum price * quantity: column list (SoA)", 1, bench_now() - s, ops);
+
+    bench_sink += (uint64_t)sum;
+    column_list_destroy(cols);
+    array_list_destroy(rows);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "bench.h"
+
+#include <sncl_hashmap.h>
+
+#define LOOKUPS (1u << 20)
+
+typedef struct {
+    uint64_t key;
+    uint64_t value;
+} pair_t;
+
+static uint64_t hash_u64(const void *key) { return *(const uint64_t *)key; }
+static bool eq_u64(const void *a, const void *b) { return *(const uint64_t *)a == *(const uint64_t *)b; }
+
+static uint64_t key_of(size_t i) { return (uint64_t)i * 0x9E3779B97F4A7C15ull; }
+
+// Looks up `lookups` keys spread over the table (half of them missing) among `n` entries, in a hash map and by scanning
+// an array of pairs
+static void bench_size(size_t n, size_t lookups) {
+    hash_map(uint64_t, uint64_t) map = hash_map_new(uint64_t, uint64_t, hash_u64, eq_u64);
+    pair_t *pairs = malloc(n * sizeof(pair_t));
+    for (size_t i = 0; i < n; i++) {
+        uint64_t k = key_of(i), v = i;
+        hash_map_put(map, k, v);
+        pairs[i] = (pair_t){k, v};
+    }
+
+    char name[64];
+    uint64_t found = 0;
+    double s = bench_now();
+    for (size_t i = 0; i < lookups; i++) {
+        uint64_t k = key_of(i * 7919 % (2 * n));
+        uint64_t *v = hash_map_get(map, k);
+        found += v ? *v : 0;
+    }
+    snprintf(name, sizeof(name), "lookup %zu entries: hashmap", n);
+    bench_report(name, 1, bench_now() - s, (double)lookups);
+
+    // the scan is O(n) per lookup, so it gets fewer of them to keep the run short, down to a handful at 10M entries
+    size_t scans = lookups / n > 8 ? lookups / n : 8;
+    s = bench_now();
+    // its keys are spread evenly over the same range, so even a handful of scans averages out
+    for (size_t i = 0; i < scans; i++) {
+        uint64_t k = key_of((2 * i + 1) * n / scans);
+        for (size_t j = 0; j < n; j++) {
+            if (pairs[j].key == k) {
+                found += pairs[j].value;
+                break;
+            }
+        }
+    }
+    snprintf(name, sizeof(name), "lookup %zu entries: linear scan", n);
+    bench_report(name, 1, bench_now() - s, (double)scans);
+
+    bench_sink += found;
+    free(pairs);
+    hash_map_destroy(map);
+}
+
+int main(int argc, char **argv) {
+    size_t lookups = LOOKUPS * bench_scale(argc, argv);
+    size_t sizes[] = {1000, 100000, 10000000};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+        bench_size(sizes[i], lookups);
+    return 0;
+}
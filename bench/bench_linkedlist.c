@@ -0,0 +1,117 @@
+#include "bench.h"
+
+#include <sncl_linkedlist.h>
+#include <sncl_unrolledlist.h>
+
+#define ELEMENTS (1u << 14)
+#define WALKS 64
+
+typedef enum { PLAIN, FINGER, INDEXED, UNROLLED } access_mode_t;
+
+// Reaches element `idx` by walking from the head every time, the way positional access worked before the finger
+static uint64_t *walk_from_head(uint64_t *list, size_t idx) {
+    linked_list_iter_t it = linked_list_iter_begin(list);
+    while (idx--)
+        linked_list_iter_next(&it);
+    return linked_list_iter_at(list, &it);
+}
+
+static void run(const char *name, access_mode_t mode, size_t *order, size_t n) {
+    linked_list(uint64_t) ll = NULL;
+    unrolled_list(uint64_t) ul = NULL;
+    if (mode == UNROLLED) {
+        ul = unrolled_list_new(uint64_t);
+        for (uint64_t i = 0; i < n; i++)
+            unrolled_list_push_back(ul, i);
+    } else {
+        ll = linked_list_new(uint64_t);
+        for (uint64_t i = 0; i < n; i++)
+            linked_list_push_back(ll, i);
+        if (mode == INDEXED) {
+            size_t stride = 1;
+            while (stride * stride < n)
+                stride *= 2;
+            linked_list_set_index_stride(ll, stride);
+        }
+    }
+
+    uint64_t sum = 0;
+    double s = bench_now();
+    for (size_t i = 0; i < n; i++) {
+        switch (mode) {
+        case PLAIN:
+            sum += *walk_from_head(ll, order[i]);
+            break;
+        case FINGER:
+        case INDEXED:
+            sum += linked_list_at(ll, order[i]);
+            break;
+        case UNROLLED:
+            sum += unrolled_list_at(ul, order[i]);
+            break;
+        }
+    }
+    bench_report(name, 1, bench_now() - s, (double)n);
+
+    bench_sink += sum;
+    if (ul)
+        unrolled_list_destroy(ul);
+    if (ll)
+        linked_list_destroy(ll);
+}
+
+// Indexes `n` 8-byte elements in order and in a random order, through each way of reaching an index, then walks the
+// linked and unrolled lists end to end with their iterators
+int main(int argc, char **argv) {
+    size_t n = ELEMENTS * bench_scale(argc, argv);
+    size_t *sequential = malloc(n * sizeof(size_t));
+    size_t *shuffled = malloc(n * sizeof(size_t));
+    uint64_t state = 88172645463325252ull;
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        sequential[i] = i;
+        shuffled[i] = (size_t)(state % n);
+    }
+
+    run("sequential get: walk from head", PLAIN, sequential, n);
+    run("sequential get: linkedlist finger", FINGER, sequential, n);
+    run("sequential get: linkedlist stride index", INDEXED, sequential, n);
+    run("sequential get: unrolled list", UNROLLED, sequential, n);
+    run("random get: walk from head", PLAIN, shuffled, n);
+    run("random get: linkedlist finger", FINGER, shuffled, n);
+    run("random get: linkedlist stride index", INDEXED, shuffled, n);
+    run("random get: unrolled list", UNROLLED, shuffled, n);
+
+    linked_list(uint64_t) ll = linked_list_new(uint64_t);
+    unrolled_list(uint64_t) ul = unrolled_list_new(uint64_t);
+    for (uint64_t i = 0; i < n; i++) {
+        linked_list_push_back(ll, i);
+        unrolled_list_push_back(ul, i);
+    }
+
+    uint64_t sum = 0;
+    double s = bench_now();
+    for (size_t r = 0; r < WALKS; r++) {
+        linked_list_start(ll);
+        for (size_t i = 0; i < n; i++)
+            sum += linked_list_next(ll);
+    }
+    bench_report("traverse: linkedlist", 1, bench_now() - s, (double)n * WALKS);
+
+    s = bench_now();
+    for (size_t r = 0; r < WALKS; r++) {
+        unrolled_list_start(ul);
+        for (size_t i = 0; i < n; i++)
+            sum += unrolled_list_next(ul);
+    }
+    bench_report("traverse: unrolled list", 1, bench_now() - s, (double)n * WALKS);
+
+    bench_sink += sum;
+    unrolled_list_destroy(ul);
+    linked_list_destroy(ll);
+    free(shuffled);
+    free(sequential);
+    return 0;
+}
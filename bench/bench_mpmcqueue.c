@@ -0,0 +1,112 @@
+#include "bench.h"
+
+#include <sncl_linkedlist.h>
+#include <sncl_mpmcqueue.h>
+
+#include <sched.h>
+
+#define ITEMS (1u << 20)
+
+typedef enum { LINKEDLIST_LOCKED, MPMC_POP, MPMC_POP_WAIT } queue_mode_t;
+
+typedef struct {
+    queue_mode_t mode;
+    void *queue;
+    pthread_mutex_t *lock; // guards the linkedlist baseline
+    size_t pushes;         // 0 for consumers
+    size_t total;
+    size_t *popped; // shared by every consumer
+    uint64_t sum;
+} worker_arg_t;
+
+static void *produce(worker_arg_t *a) {
+    mpmc_queue_handle_t *h = a->mode == LINKEDLIST_LOCKED ? NULL : mpmc_queue_attach(a->queue);
+    for (size_t i = 0; i < a->pushes; i++) {
+        uint64_t v = i;
+        if (h) {
+            mpmc_queue__push(a->queue, h, &v);
+        } else {
+            pthread_mutex_lock(a->lock);
+            linked_list__push_back(a->queue, &v);
+            pthread_mutex_unlock(a->lock);
+        }
+    }
+    if (h)
+        mpmc_queue_detach(a->queue, h);
+    return NULL;
+}
+
+// Pops until every consumer together has seen all the items, yielding whenever the queue turns up empty
+static void *consume(worker_arg_t *a) {
+    mpmc_queue_handle_t *h = a->mode == LINKEDLIST_LOCKED ? NULL : mpmc_queue_attach(a->queue);
+    while (__atomic_load_n(a->popped, __ATOMIC_RELAXED) < a->total) {
+        uint64_t v;
+        bool got;
+        if (a->mode == MPMC_POP) {
+            got = mpmc_queue__pop(a->queue, h, &v);
+        } else if (a->mode == MPMC_POP_WAIT) {
+            got = mpmc_queue__pop_wait(a->queue, h, &v, 1);
+        } else {
+            pthread_mutex_lock(a->lock);
+            got = !linked_list_empty(a->queue);
+            if (got) {
+                v = *(uint64_t *)linked_list__front(a->queue);
+                linked_list__pop_front(a->queue);
+            }
+            pthread_mutex_unlock(a->lock);
+        }
+
+        if (got) {
+            a->sum += v;
+            __atomic_fetch_add(a->popped, 1, __ATOMIC_RELAXED);
+        } else if (a->mode != MPMC_POP_WAIT) {
+            sched_yield();
+        }
+    }
+    if (h)
+        mpmc_queue_detach(a->queue, h);
+    return NULL;
+}
+
+static void *worker(void *p) {
+    worker_arg_t *a = p;
+    return a->pushes ? produce(a) : consume(a);
+}
+
+// Runs `t` producers against `t` consumers for every thread count, moving `total` items through a fresh queue each run
+static void run(const char *name, queue_mode_t mode, size_t total) {
+    for (size_t i = 0; i < BENCH_THREAD_COUNTS; i++) {
+        size_t t = bench_threads(i);
+        if (!t)
+            continue;
+
+        pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+        void *queue = mode == LINKEDLIST_LOCKED ? (void *)linked_list_new(uint64_t) : mpmc_queue_new(uint64_t, 2 * t);
+        size_t per_producer = total / t, popped = 0;
+
+        worker_arg_t *args = malloc(2 * t * sizeof(worker_arg_t));
+        for (size_t j = 0; j < 2 * t; j++)
+            args[j] = (worker_arg_t){ mode, queue, &lock, j < t ? per_producer : 0, per_producer * t, &popped, 0 };
+        double s = bench_run_threads(2 * t, worker, args, sizeof(worker_arg_t));
+        bench_report(name, t, s, (double)(per_producer * t));
+
+        for (size_t j = t; j < 2 * t; j++)
+            bench_sink += args[j].sum;
+        if (mode == LINKEDLIST_LOCKED)
+            linked_list_destroy(queue);
+        else
+            mpmc_queue_destroy(queue);
+        pthread_mutex_destroy(&lock);
+        free(args);
+    }
+}
+
+// Thread counts are per side, so the 4 thread rows run 4 producers and 4 consumers
+int main(int argc, char **argv) {
+    size_t total = ITEMS * bench_scale(argc, argv);
+
+    run("push/pop: linkedlist + mutex", LINKEDLIST_LOCKED, total);
+    run("push/pop: mpmc queue", MPMC_POP, total);
+    run("push/pop_wait: mpmc queue", MPMC_POP_WAIT, total);
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include "bench.h"
+
+#include <sncl_arraylist.h>
+#include <sncl_seglist.h>
+
+#define PUSHES (1u << 22)
+
+typedef struct {
+    void *list;
+    pthread_mutex_t *lock; // set for the mutex-guarded baselines
+    size_t pushes;
+    uint64_t base;
+} producer_arg_t;
+
+// Pushes into one shared arraylist behind a mutex, like the ingest threads did before concurrent appends
+static void *push_arraylist_locked(void *p) {
+    producer_arg_t *a = p;
+    uint64_t **list = a->list;
+    for (size_t i = 0; i < a->pushes; i++) {
+        uint64_t v = a->base + i;
+        pthread_mutex_lock(a->lock);
+        array_list_push_back(*list, v);
+        pthread_mutex_unlock(a->lock);
+    }
+    return NULL;
+}
+
+// Pushes into one shared segmented list behind a mutex
+static void *push_seglist_locked(void *p) {
+    producer_arg_t *a = p;
+    for (size_t i = 0; i < a->pushes; i++) {
+        uint64_t v = a->base + i;
+        pthread_mutex_lock(a->lock);
+        seg_list__push_back(a->list, &v);
+        pthread_mutex_unlock(a->lock);
+    }
+    return NULL;
+}
+
+// Pushes into one shared segmented list with no lock at all
+static void *push_seglist_concurrent(void *p) {
+    producer_arg_t *a = p;
+    for (size_t i = 0; i < a->pushes; i++) {
+        uint64_t v = a->base + i;
+        seg_list__push_back_concurrent(a->list, &v);
+    }
+    return NULL;
+}
+
+typedef enum { ARRAYLIST_LOCKED, SEGLIST_LOCKED, SEGLIST_CONCURRENT, SEGLIST_CONCURRENT_RESERVED } push_mode_t;
+
+// Splits `total` pushes over every thread count, a fresh list per run so each one pays for its own growth
+static void run(const char *name, push_mode_t mode, size_t total) {
+    for (size_t i = 0; i < BENCH_THREAD_COUNTS; i++) {
+        size_t t = bench_threads(i);
+        if (!t)
+            continue;
+
+        pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+        uint64_t *arr = NULL;
+        void *list;
+        void *(*fn)(void *);
+        if (mode == ARRAYLIST_LOCKED) {
+            arr = array_list_new(uint64_t);
+            list = &arr;
+            fn = push_arraylist_locked;
+        } else {
+            list = seg_list_new(uint64_t);
+            if (mode == SEGLIST_CONCURRENT_RESERVED)
+                seg_list_reserve(list, total);
+            fn = mode == SEGLIST_LOCKED ? push_seglist_locked : push_seglist_concurrent;
+        }
+
+        producer_arg_t *args = malloc(t * sizeof(producer_arg_t));
+        for (size_t j = 0; j < t; j++)
+            args[j] = (producer_arg_t){list, &lock, total / t, (uint64_t)j * (total / t)};
+        double s = bench_run_threads(t, fn, args, sizeof(producer_arg_t));
+        bench_report(name, t, s, (double)(total / t * t));
+
+        if (mode == ARRAYLIST_LOCKED) {
+            bench_sink += array_list_size(arr);
+            array_list_destroy(arr);
+        } else {
+            bench_sink += seg_list_published(list);
+            seg_list_destroy(list);
+        }
+        pthread_mutex_destroy(&lock);
+        free(args);
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t total = PUSHES * bench_scale(argc, argv);
+
+    run("push: arraylist + mutex", ARRAYLIST_LOCKED, total);
+    run("push: seglist + mutex", SEGLIST_LOCKED, total);
+    run("push: seglist concurrent", SEGLIST_CONCURRENT, total);
+    run("push: seglist concurrent, reserved", SEGLIST_CONCURRENT_RESERVED, total);
+    return 0;
+}
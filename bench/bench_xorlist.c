@@ -0,0 +1,101 @@
+#include "bench.h"
+
+#include <sncl_linkedlist.h>
+#include <sncl_xorlist.h>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define HEAP_IN_USE
+#endif
+
+#define ELEMENTS (1u << 22)
+#define WALKS 8
+
+typedef enum { LINKED, POOLED, XOR } layout_t;
+
+// Returns the bytes the heap currently hands out, or 0 where that can't be asked for
+static size_t heap_in_use(void) {
+#ifdef HEAP_IN_USE
+    struct mallinfo2 mi = mallinfo2();
+    return mi.uordblks + mi.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+// Pushes `n` 8-byte elements to the back, walks them front to back `WALKS` times, then pops them all off the front,
+// reporting the memory held per element once the list is full
+static void run(const char *name, layout_t layout, size_t n) {
+    char row[64];
+    size_t heap_before = heap_in_use();
+    linked_list(uint64_t) ll = NULL;
+    xor_list(uint64_t) xl = NULL;
+    if (layout == XOR)
+        xl = xor_list_new(uint64_t);
+    else
+        ll = layout == POOLED ? linked_list_new_pooled(uint64_t, 4096) : linked_list_new(uint64_t);
+
+    double s = bench_now();
+    for (uint64_t i = 0; i < n; i++) {
+        if (xl)
+            xor_list_push_back(xl, i);
+        else
+            linked_list_push_back(ll, i);
+    }
+    snprintf(row, sizeof(row), "push_back: %s", name);
+    bench_report(row, 1, bench_now() - s, (double)n);
+
+    size_t heap_used = heap_in_use() - heap_before;
+    snprintf(row, sizeof(row), "memory: %s", name);
+    if (xl)
+        printf("%-44s %10.2f bytes/elem (xor_list_memory_usage %.2f)\n", row, (double)heap_used / (double)n,
+               (double)xor_list_memory_usage(xl) / (double)n);
+    else
+        printf("%-44s %10.2f bytes/elem\n", row, (double)heap_used / (double)n);
+
+    uint64_t sum = 0;
+    s = bench_now();
+    for (size_t r = 0; r < WALKS; r++) {
+        if (xl) {
+            for (xor_list_iter_t it = xor_list_begin(xl); xor_list_iter_get(xl, &it); xor_list_iter_next(xl, &it))
+                sum += *xor_list_iter_at(xl, &it);
+        } else {
+            for (linked_list_iter_t it = linked_list_iter_begin(ll); linked_list_iter_get(&it);
+                 linked_list_iter_next(&it))
+                sum += *linked_list_iter_at(ll, &it);
+        }
+    }
+    snprintf(row, sizeof(row), "walk: %s", name);
+    bench_report(row, 1, bench_now() - s, (double)n * WALKS);
+
+    s = bench_now();
+    for (size_t i = 0; i < n; i++) {
+        if (xl) {
+            sum += xor_list_front(xl);
+            xor_list__pop_front(xl);
+        } else {
+            sum += linked_list_front(ll);
+            linked_list__pop_front(ll);
+        }
+    }
+    snprintf(row, sizeof(row), "pop_front: %s", name);
+    bench_report(row, 1, bench_now() - s, (double)n);
+
+    bench_sink += sum;
+    if (xl)
+        xor_list_destroy(xl);
+    else
+        linked_list_destroy(ll);
+}
+
+int main(int argc, char **argv) {
+    size_t n = ELEMENTS * bench_scale(argc, argv);
+
+    run("linkedlist", LINKED, n);
+    run("linkedlist pooled", POOLED, n);
+    run("xorlist", XOR, n);
+#ifndef HEAP_IN_USE
+    printf("(heap usage is only measured on glibc, bytes/elem above read 0 elsewhere)\n");
+#endif
+    return 0;
+}
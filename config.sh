@@ -3,9 +3,9 @@
 # Yeah I wrote a config script so what
 # Run it with ./config.sh
 
-MODULES="C_LEXER CLI_OPTS ARRAYLIST LINKEDLIST YOUTUBE_TOOLS"
-MODULE_NAMES="C Lexer|CLI option handler|ArrayLists|LinkedLists|Youtube tools"
-ENABLED="n y y y n"
+MODULES="C_LEXER CLI_OPTS ARRAYLIST ARRAYLIST_ALGO ARENA SEGLIST DEQUE FLATSET HASHMAP BITLIST COLUMNLIST LINKEDLIST UNROLLEDLIST INTRUSIVELIST XORLIST MPMCQUEUE YOUTUBE_TOOLS"
+MODULE_NAMES="C Lexer|CLI option handler|ArrayLists|ArrayList algorithms|Arena allocator|Segmented lists|Deques|Flat sets|HashMaps|Bit lists|Column lists|LinkedLists|Unrolled lists|Intrusive lists|XOR lists|MPMC queues|Youtube tools"
+ENABLED="n y y y y y y y y y y y y y y y n"
 
 set -e
 
@@ -0,0 +1,27 @@
+/* SNCL Allocator v1.00
+   Defines a small allocator vtable that SNCL containers can be created with instead of the global heap.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_ALLOCATOR_H__
+#define SNCL_ALLOCATOR_H__
+
+#include <stddef.h>
+
+// Allocator interface used by allocator-aware SNCL containers.
+// `ctx` is handed back to every callback untouched. Sizes passed to `realloc` and `free` are always the exact sizes
+// the block was last allocated with, so simple bump/pool allocators don't need to track them themselves.
+// The vtable is referenced (not copied) by containers, so it must outlive every container created with it.
+typedef struct sncl_allocator {
+    // Allocates `size` bytes, returning `NULL` on failure.
+    void *(*alloc)(void *ctx, size_t size);
+    // Resizes the block at `ptr` from `old_size` to `new_size` bytes, returning `NULL` on failure.
+    void *(*realloc)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    // Releases the block at `ptr`. May be a no-op (ex. for arenas).
+    void (*free)(void *ctx, void *ptr, size_t size);
+    void *ctx;
+} sncl_allocator_t;
+
+#endif // SNCL_ALLOCATOR_H__
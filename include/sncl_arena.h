@@ -0,0 +1,40 @@
+/* SNCL Arena v1.00
+   Defines a bump/arena allocator that releases everything it handed out in one go.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_ARENA_H__
+#define SNCL_ARENA_H__
+
+#include <stddef.h>
+
+#include "sncl_allocator.h"
+
+// An arena is NOT thread-safe, give each thread its own arena instead of sharing one.
+typedef struct sncl_arena sncl_arena_t;
+
+// Creates an arena that grabs memory from the heap in blocks of (at least) `block_size` bytes.
+// Passing `0` uses the default block size of 64KiB. Returns `NULL` if the arena could not be allocated.
+sncl_arena_t *sncl_arena_create(size_t block_size);
+// Destroys an arena, freeing every block it owns. Anything allocated from it is invalid afterwards.
+void sncl_arena_destroy(sncl_arena_t *arena);
+
+// Allocates `size` bytes from the arena, aligned for any fundamental type. Returns `NULL` if out of memory.
+void *sncl_arena_alloc(sncl_arena_t *arena, size_t size);
+// Resizes an allocation made from the arena. If `ptr` is the most recent allocation it is grown in place when there is
+// room, otherwise a new block is handed out and the old contents are copied over.
+void *sncl_arena_realloc(sncl_arena_t *arena, void *ptr, size_t old_size, size_t new_size);
+// Releases every allocation made from the arena at once, keeping its blocks around for reuse.
+// This function runs in `O(blocks)` complexity, no matter how many allocations were made.
+void sncl_arena_reset(sncl_arena_t *arena);
+
+// Returns the total number of bytes the arena currently holds from the heap.
+size_t sncl_arena_reserved(sncl_arena_t *arena);
+
+// Returns an allocator vtable backed by the arena, for use with allocator-aware containers.
+// Freeing through this allocator is a no-op, memory only comes back on `sncl_arena_reset` or `sncl_arena_destroy`.
+const sncl_allocator_t *sncl_arena_allocator(sncl_arena_t *arena);
+
+#endif // SNCL_ARENA_H__
@@ -1,4 +1,4 @@
-/* SNCL ArrayList v1.01
+/* SNCL ArrayList v1.12
    Defines an interface for dynamic custom-type arrays in C.
 
    Contributors:
@@ -11,16 +11,76 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "sncl_allocator.h"
 #include "sncl_typeid.h"
 
 // Standard definition for a public arraylist type
 #define array_list(type) type *
 
+// Upper bound on the bytes an arraylist header takes up in front of its elements, used to size inline storage.
+#define ARRAY_LIST_HEADER_SIZE (12 * sizeof(size_t))
+
+// How an arraylist picks its new capacity once it runs out of room.
+typedef enum {
+    ARRAY_LIST_GROW_DOUBLE = 0, // Doubles the capacity (the default).
+    ARRAY_LIST_GROW_HALF,       // Grows the capacity by 1.5x, wasting less memory at the cost of more reallocations.
+    ARRAY_LIST_GROW_FIXED,      // Grows the capacity by a fixed number of elements, given as the policy parameter.
+    ARRAY_LIST_GROW_PAGED       // Doubles up to a threshold in bytes, then grows by 1.5x rounded up to whole pages.
+} array_list_growth_t;
+
+// The header every arraylist keeps right in front of its elements. Only exposed so `SNCL_ARRAYLIST_DEFINE` can inline
+// against it, none of the fields should be written to directly.
+typedef struct {
+    const sncl_allocator_t *allocator; // `NULL` means the global heap
+    array_list_growth_t growth;
+    size_t growth_param;
+
+    size_t reallocations;
+    size_t bytes_copied;
+
+    size_t alignment; // alignment of `data`, `0` for whatever the allocator hands out
+    size_t padding;   // bytes between the start of the allocated block and the header
+
+    size_t type_size;
+    size_t capacity;
+    size_t size;
+    unsigned char data[];
+} array_list_header_t;
+
+// Returns the header of an arraylist.
+#define array_list_header(list) ((array_list_header_t *)((unsigned char *)(list) - offsetof(array_list_header_t, data)))
+
+// How a file backed arraylist is opened.
+typedef enum {
+    ARRAY_LIST_MAP_READ_WRITE = 0, // Changes are written back to the file, which is created if it doesn't exist.
+    ARRAY_LIST_MAP_READ_ONLY       // The file is never written to and the arraylist can't grow.
+} array_list_map_mode_t;
+
 // Creates an arraylist given the type size and initial capacity, returning it as a `void*`.
 // It is recommended that you use the public facing API `array_list_new(type)`.
 void *array_list_create(size_t type_size, size_t init_cap);
+// Creates an arraylist like `array_list_create`, drawing all of its memory from `allocator` instead of the global heap.
+// Passing `NULL` as the allocator is the same as calling `array_list_create`. The allocator must outlive the list.
+// It is recommended that you use the public facing API `array_list_new_with(type, allocator)`.
+void *array_list_create_with(size_t type_size, size_t init_cap, const sncl_allocator_t *allocator);
+// Creates an arraylist whose element storage starts on an `alignment` byte boundary (ex. `32` for AVX, `64` for a cache
+// line), which is kept through every reallocation. `alignment` must be a power of two.
+// It is recommended that you use the public facing API `array_list_new_aligned(type, alignment)`.
+void *array_list_create_aligned(size_t type_size, size_t init_cap, size_t alignment);
+// Creates an arraylist inside `buffer` (ex. a stack array or a struct member), holding as many elements as fit in
+// `buffer_size` bytes after the header without touching the heap. Once it outgrows the buffer, the arraylist moves
+// itself to the heap and carries on as usual. `array_list_destroy` must still be called, but only frees heap memory.
+// The buffer must be aligned for `size_t` and outlive the arraylist while it is still inline.
+// It is recommended that you use `array_list_inline_storage` and `array_list_new_inline` instead.
+void *array_list_create_inline(size_t type_size, void *buffer, size_t buffer_size);
+// Returns `true` if the arraylist still lives inside the buffer it was created in.
+bool array_list_is_inline(void *list);
 // Destroys an arraylist. We recommend you cast it to `void *` beforehand, ex `array_list_destroy((void *)list);`.
 void array_list_destroy(void *list);
+// Returns the allocator the arraylist was created with, or `NULL` if it lives on the global heap.
+const sncl_allocator_t *array_list_allocator(void *list);
+// Returns the alignment the arraylist was created with, or `0` if it was created without one.
+size_t array_list_alignment(void *list);
 
 // Returns the beginning pointer of the arraylist as `void *`.
 void *array_list_vbegin(void *list);
@@ -31,12 +91,24 @@ void *array_list_vend(void *list);
 bool array_list_empty(void *list);
 // Returns the size of the arraylist.
 size_t array_list_size(void *list);
+// Returns the size in bytes of a single element of the arraylist.
+size_t array_list_type_size(void *list);
 // Returns the capacity of the arraylist, as in the max size the arraylist can store before resizing.
 size_t array_list_capacity(void *list);
 
 // Voided pushback method. Pushes a value to the end of the arraylist.
 // It is recommended that you use the public facing API `array_list_push_back(list, value)`.
 void array_list_vpush_back(void **list, void *value);
+// Voided bulk pushback method. Pushes `n` values from `values` to the end of the arraylist, growing it at most once.
+// `values` may point into the arraylist itself.
+// It is recommended that you use the public facing API `array_list_push_back_n(list, ptr, n)`.
+void array_list_vpush_back_n(void **list, const void *values, size_t n);
+// Voided emplace method. Grows the arraylist by `n` elements (reallocating at most once) and returns a pointer to the
+// first of them, left uninitialized for the caller to fill in. Returns `NULL`, leaving the arraylist unchanged, if it
+// can't grow.
+// It is recommended that you use the public facing APIs `array_list_emplace_back(list)` and
+// `array_list_emplace_back_n(list, n)`.
+void *array_list_vemplace_back_n(void **list, size_t n);
 // Voided insert method. Inserts a range of values at a specific index in the arraylist.
 // It is recommended that you use the public facing API `array_list_insert(list, pos, begin, end)`.
 void array_list_vinsert(void **list, void *at, void *begin, void *end);
@@ -47,8 +119,60 @@ void array_list_clear(void *list);
 // It is recommended that you use the public facing API `array_list_reserve(list, new_cap)`.
 void array_list_vreserve(void **list, size_t cap);
 
+// Voided shrink method. Reallocates the arraylist so its capacity exactly matches its size, giving memory back.
+// It is recommended that you use the public facing API `array_list_shrink_to_fit(list)`.
+void array_list_vshrink_to_fit(void **list);
+
+// Sets the growth policy of the arraylist. `param` is the increment in elements for `ARRAY_LIST_GROW_FIXED`, the
+// threshold in bytes for `ARRAY_LIST_GROW_PAGED` and ignored otherwise. Explicit reserves are always exact.
+void array_list_set_growth(void *list, array_list_growth_t growth, size_t param);
+// Returns the growth policy of the arraylist.
+array_list_growth_t array_list_growth(void *list);
+// Returns how many times the arraylist has been reallocated over its lifetime.
+size_t array_list_reallocations(void *list);
+// Returns how many bytes of elements had to be copied because a reallocation moved the arraylist.
+size_t array_list_bytes_copied(void *list);
+
+// Opens an arraylist that lives in the file at `path` (both its header and elements), mapped straight into memory.
+// Nothing is parsed or copied when opening, pages are only read in as they are touched. Growing the arraylist resizes
+// the file and the mapping together. A read-only arraylist can't grow: pushes and inserts past its capacity leave it
+// unchanged and emplacing returns `NULL`. `array_list_destroy` unmaps the file and closes it.
+// Read-only arraylists share their elements with every other process mapping the same file, anything written to them
+// is private to the process and never reaches the file. Only the `type_size` the file was created with is accepted.
+// Returns `NULL` if the file can't be opened or doesn't hold an arraylist of `type_size` elements (or on platforms
+// without `mmap`). The file layout follows the in-memory header, so it is only portable between identical builds. The
+// header's allocator slot holds a fixed tag in the file, never a pointer into the process that opened it.
+// It is recommended that you use the public facing API `array_list_map(type, path, mode)`.
+void *array_list_open_mapped(const char *path, size_t type_size, array_list_map_mode_t mode);
+// Returns `true` if the arraylist was opened by `array_list_open_mapped`.
+bool array_list_is_mapped(void *list);
+// Synchronously writes a file backed arraylist back to its file. Returns `false` if the arraylist is read-only, isn't
+// file backed or the write failed (including a file that couldn't be resized back after a failed resize).
+bool array_list_flush(void *list);
+
+// Writes the arraylist to the file descriptor `fd` in a versioned binary layout: a header recording the element size,
+// count, alignment and byte order, followed by a ready-made arraylist header and the raw element bytes, aligned to at
+// least 64 bytes from the start of the output. Returns `false` if a write failed (or on platforms without POSIX I/O).
+bool array_list_write(int fd, void *list);
+// Returns a read-only arraylist view of a buffer holding what `array_list_write` wrote (ex. an `mmap` of the file),
+// pointing straight into the buffer without copying anything. The buffer must be aligned to the alignment it was
+// written with (page aligned mappings always are) and outlive the view. Returns `NULL` if the buffer is too short, is
+// misaligned, or was written by a different format version, byte order or word size.
+// Every read works on a view, but it can't be grown and must not be written to. `array_list_destroy` is a no-op.
+void *array_list_read_view(const void *buffer, size_t length);
+// Returns `true` if the arraylist is a view returned by `array_list_read_view`.
+bool array_list_is_view(void *list);
+
 // Erases a range inside the arraylist, moving elements down as necessary.
 void array_list_erase(void *list, void *begin, void *end);
+// Erases every element for which `pred(element, ctx)` returns `true`, keeping the order of the rest. Runs in a single
+// pass, moving each kept element at most once. Returns how many elements were erased.
+size_t array_list_erase_if(void *list, bool (*pred)(const void *elem, void *ctx), void *ctx);
+// Erases the element at `idx` in `O(1)` by moving the last element into its place. Does not preserve order.
+void array_list_swap_remove(void *list, size_t idx);
+// Erases the elements at the `count` given indices, which must be sorted in ascending order without duplicates.
+// Runs in a single pass over the arraylist, keeping the order of the rest.
+void array_list_erase_indices(void *list, const size_t *indices, size_t count);
 
 // Returns the start of the arraylist as a type pointer.
 #define array_list_begin(list) ((typeof(list))array_list_vbegin((void *)list))
@@ -62,6 +186,24 @@ void array_list_erase(void *list, void *begin, void *end);
 
 // Creates a new arraylist given a desired type.
 #define array_list_new(type) (type *)array_list_create(sizeof(type), 16)
+// Creates a new arraylist given a desired type, with room for exactly `cap` elements before it has to grow.
+#define array_list_new_with_capacity(type, cap) (type *)array_list_create(sizeof(type), cap)
+// Creates a new arraylist given a desired type, with its elements aligned to `alignment` bytes.
+#define array_list_new_aligned(type, alignment) (type *)array_list_create_aligned(sizeof(type), 16, alignment)
+// Creates a new arraylist given a desired type, allocating through `allocator` (ex. `sncl_arena_allocator(arena)`).
+#define array_list_new_with(type, allocator) (type *)array_list_create_with(sizeof(type), 16, allocator)
+
+// Declares `name` as storage for an inline arraylist of up to `n` elements of `type`.
+#define array_list_inline_storage(type, n, name)                                                                       \
+    union {                                                                                                            \
+        unsigned char bytes[ARRAY_LIST_HEADER_SIZE + sizeof(type) * (n)];                                              \
+        size_t align_;                                                                                                 \
+        void *align_ptr_;                                                                                              \
+    } name
+// Creates a new arraylist given a desired type inside storage declared with `array_list_inline_storage`.
+#define array_list_new_inline(type, storage) (type *)array_list_create_inline(sizeof(type), &(storage), sizeof(storage))
+// Opens a file backed arraylist of the given type.
+#define array_list_map(type, path, mode) (type *)array_list_open_mapped(path, sizeof(type), mode)
 
 // Returns the first element of the arraylist, copied.
 #define array_list_front(list) (*(typeof(list))array_list_vbegin((void *)list))
@@ -72,10 +214,56 @@ void array_list_erase(void *list, void *begin, void *end);
 
 // Pushes a value to the end of the arraylist. Must be an lvalue.
 #define array_list_push_back(list, value) array_list_vpush_back((void **)(&list), (void *)(&(value)))
+// Pushes a value to the end of the arraylist, accepting rvalues by wrapping them in a compound literal.
+// The arguments are the initializer, so structs can be pushed as `array_list_push_back_rv(list, .x = 1, .y = 2)`.
+#define array_list_push_back_rv(list, ...)                                                                             \
+    array_list_vpush_back((void **)(&list), (void *)&(typeof(*(list))){ __VA_ARGS__ })
+// Pushes `n` elements starting at `ptr` to the end of the arraylist.
+#define array_list_push_back_n(list, ptr, n) array_list_vpush_back_n((void **)(&list), (const void *)(ptr), n)
+// Appends an uninitialized element to the arraylist, returning a typed pointer to it.
+#define array_list_emplace_back(list) ((typeof(list))array_list_vemplace_back_n((void **)(&list), 1))
+// Appends `n` uninitialized elements to the arraylist, returning a typed pointer to the first one.
+#define array_list_emplace_back_n(list, n) ((typeof(list))array_list_vemplace_back_n((void **)(&list), n))
 // Inserts a range to a specific position in the arraylist.
 #define array_list_insert(list, pos, begin, end)                                                                       \
     array_list_vinsert((void **)(&list), (void *)(pos), (void *)(begin), (void *)(end))
 // Reserves a minimum capacity in the arraylist.
 #define array_list_reserve(list, new_cap) array_list_vreserve((void **)(&list), new_cap)
+// Shrinks the capacity of the arraylist down to its size.
+#define array_list_shrink_to_fit(list) array_list_vshrink_to_fit((void **)(&list))
+
+// Defines a set of `static inline` functions prefixed with `name` for arraylists of `type`, ex.
+// `SNCL_ARRAYLIST_DEFINE(int, intlist)` defines `intlist_push_back`, `intlist_at`, etc. With the element size known at
+// compile time, size lookups and element accesses fold into plain loads and stores and a push only leaves the header
+// when the arraylist has to grow. The lists are ordinary arraylists, so both APIs can be mixed freely.
+#define SNCL_ARRAYLIST_DEFINE(type, name)                                                                              \
+    static inline type *name##_new(void) { return (type *)array_list_create(sizeof(type), 16); }                      \
+    static inline type *name##_new_with_capacity(size_t cap) { return (type *)array_list_create(sizeof(type), cap); } \
+    static inline void name##_destroy(type *list) { array_list_destroy((void *)list); }                               \
+    static inline size_t name##_size(const type *list) { return array_list_header(list)->size; }                      \
+    static inline size_t name##_capacity(const type *list) { return array_list_header(list)->capacity; }              \
+    static inline bool name##_empty(const type *list) { return array_list_header(list)->size == 0; }                  \
+    static inline type *name##_begin(type *list) { return list; }                                                     \
+    static inline type *name##_end(type *list) { return list + array_list_header(list)->size; }                       \
+    static inline type name##_at(const type *list, size_t idx) { return list[idx]; }                                  \
+    static inline type name##_front(const type *list) { return list[0]; }                                             \
+    static inline type name##_back(const type *list) { return list[array_list_header(list)->size - 1]; }              \
+    static inline void name##_push_back(type **list, type value) {                                                     \
+        array_list_header_t *hdr = array_list_header(*list);                                                           \
+        type *slot;                                                                                                    \
+        if (hdr->size < hdr->capacity)                                                                                 \
+            (*list)[hdr->size++] = value;                                                                              \
+        else if ((slot = (type *)array_list_vemplace_back_n((void **)list, 1)))                                        \
+            *slot = value;                                                                                             \
+    }                                                                                                                  \
+    static inline type *name##_emplace_back(type **list) {                                                             \
+        array_list_header_t *hdr = array_list_header(*list);                                                           \
+        if (hdr->size < hdr->capacity)                                                                                 \
+            return *list + hdr->size++;                                                                                \
+        return (type *)array_list_vemplace_back_n((void **)list, 1);                                                   \
+    }                                                                                                                  \
+    static inline type name##_pop_back(type *list) { return list[--array_list_header(list)->size]; }                  \
+    static inline void name##_clear(type *list) { array_list_header(list)->size = 0; }                                \
+    static inline void name##_reserve(type **list, size_t cap) { array_list_vreserve((void **)list, cap); }
 
 #endif // SNCL_ARRAYLIST_H__
@@ -0,0 +1,74 @@
+/* SNCL ArrayList Algorithms v1.02
+   Defines bulk search, reduction and sorting algorithms over arraylists, vectorized with SSE2/AVX2 where the CPU allows
+   it.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_ARRAYLIST_ALGO_H__
+#define SNCL_ARRAYLIST_ALGO_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sncl_arraylist.h"
+#include "sncl_typeid.h"
+
+// Element kinds understood by the numeric algorithms.
+typedef enum {
+    ARRAY_LIST_I8,
+    ARRAY_LIST_U8,
+    ARRAY_LIST_I16,
+    ARRAY_LIST_U16,
+    ARRAY_LIST_I32,
+    ARRAY_LIST_U32,
+    ARRAY_LIST_I64,
+    ARRAY_LIST_U64,
+    ARRAY_LIST_F32,
+    ARRAY_LIST_F64
+} array_list_kind_t;
+
+// Returns a pointer to the first element bitwise equal to `value`, or `array_list_vend(list)` if there is none.
+// Elements of 1, 2, 4 and 8 bytes are compared 16 or 32 bytes at a time, anything else falls back to `memcmp`.
+// Note that floats are compared bitwise too, so `-0.0` does not match `0.0` and a NaN matches an identical NaN.
+// It is recommended that you use the public facing API `array_list_find(list, value)`.
+void *array_list_vfind(void *list, const void *value);
+// Returns `true` if any element is bitwise equal to `value`.
+// It is recommended that you use the public facing API `array_list_contains(list, value)`.
+bool array_list_vcontains(void *list, const void *value);
+// Returns how many elements are bitwise equal to `value`.
+// It is recommended that you use the public facing API `array_list_count(list, value)`.
+size_t array_list_vcount(void *list, const void *value);
+
+// Sums every element of the arraylist, interpreting them as `kind`.
+// `out` must point to an `int64_t` for signed kinds, a `uint64_t` for unsigned kinds and a `double` for float kinds.
+// Integer sums wrap on overflow. Float sums may round differently from a plain loop as they are added out of order.
+void array_list_vsum(void *list, array_list_kind_t kind, void *out);
+// Finds the smallest and largest elements of the arraylist, interpreting them as `kind`.
+// `min` and `max` must point to the element type, either may be `NULL`. Returns `false` if the arraylist is empty.
+// The result is unspecified if a float arraylist contains NaN.
+bool array_list_vmin_max(void *list, array_list_kind_t kind, void *min, void *max);
+
+// Sorts the arraylist with a stable merge sort, ordered by `cmp` (same contract as the `qsort` comparator).
+void array_list_sort(void *list, int (*cmp)(const void *, const void *));
+// Sorts the arraylist like `array_list_sort`, splitting the work over up to `threads` threads (`0` uses one per online
+// CPU). Each thread sorts a chunk and the chunks are then merged pairwise, with every thread taking a slice of each
+// merge. Small arraylists, and platforms without pthreads, are sorted on the calling thread.
+// The worker threads are created on first use and reused by later sorts for the life of the process. Only one parallel
+// sort runs on them at a time, a sort started while another one holds the workers is done on its calling thread.
+void array_list_sort_parallel(void *list, int (*cmp)(const void *, const void *), size_t threads);
+// Sorts the arraylist in ascending order with an LSD radix sort, interpreting the elements as `kind`.
+// Runs in `O(n)` for every kind, skipping byte passes where all keys agree. Negative floats sort before positive ones,
+// `-0.0` sorts before `0.0` and NaNs are placed by their bit pattern at either end.
+// Returns `false`, leaving the arraylist untouched, if `kind` doesn't have the same size as the arraylist's elements.
+bool array_list_sort_radix(void *list, array_list_kind_t kind);
+
+// Returns a pointer to the first element equal to `value`, or `array_list_end(list)`. Must be an lvalue.
+#define array_list_find(list, value) ((typeof(list))array_list_vfind((void *)(list), (const void *)(&(value))))
+// Returns whether the arraylist contains `value`. Must be an lvalue.
+#define array_list_contains(list, value) array_list_vcontains((void *)(list), (const void *)(&(value)))
+// Returns how many times `value` appears in the arraylist. Must be an lvalue.
+#define array_list_count(list, value) array_list_vcount((void *)(list), (const void *)(&(value)))
+
+#endif // SNCL_ARRAYLIST_ALGO_H__
@@ -0,0 +1,88 @@
+/* SNCL Bit List v1.00
+   Defines packed bit vectors and fixed-width small-integer lists in C.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_BITLIST_H__
+#define SNCL_BITLIST_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Standard definition for a public bit list type
+#define bit_list uint64_t *
+// Standard definition for a public packed integer list type
+#define packed_list uint64_t *
+
+// Both containers keep their header in front of their storage like an arraylist, and hand out a pointer to the 64-bit
+// words that hold the entries. Bit lists store one bit per entry, bit `i` being bit `i % 64` of word `i / 64`. Packed
+// lists store `width` bits per entry (1 to 7), as many as fit in each word without straddling two. Bits past the last
+// entry are always kept clear, so the words can be scanned whole.
+
+//// bit lists
+
+// Creates an empty bit list with room for `init_cap` bits.
+uint64_t *bit_list_create(size_t init_cap);
+// Destroys a bit list.
+void bit_list_destroy(uint64_t *bits);
+
+// Returns the number of bits in the bit list.
+size_t bit_list_size(const uint64_t *bits);
+// Returns the number of words holding the bits of the bit list.
+size_t bit_list_word_count(const uint64_t *bits);
+// Returns the bit at `idx`.
+bool bit_list_get(const uint64_t *bits, size_t idx);
+// Sets the bit at `idx` to `value`.
+void bit_list_set(uint64_t *bits, size_t idx, bool value);
+
+// Voided pushback method. Pushes a bit to the end of the bit list.
+// It is recommended that you use the public facing API `bit_list_push_back(bits, value)`.
+void bit_list_vpush_back(uint64_t **bits, bool value);
+// Voided resize method. Grows or shrinks the bit list to `size` bits, new bits being clear.
+// It is recommended that you use the public facing API `bit_list_resize(bits, size)`.
+void bit_list_vresize(uint64_t **bits, size_t size);
+// Clears every bit without changing the size.
+void bit_list_reset(uint64_t *bits);
+
+// Returns the number of set bits.
+size_t bit_list_popcount(const uint64_t *bits);
+// Returns the index of the first set bit at or after `from`, or the size of the bit list if there is none.
+size_t bit_list_find_first_set(const uint64_t *bits, size_t from);
+
+// Combines `src` into `dst` a whole word at a time (which compilers turn into SIMD loops). Both must have the same size.
+void bit_list_and(uint64_t *dst, const uint64_t *src);
+void bit_list_or(uint64_t *dst, const uint64_t *src);
+void bit_list_xor(uint64_t *dst, const uint64_t *src);
+
+//// packed integer lists
+
+// Creates an empty packed list of `width` bit entries (1 to 7) with room for `init_cap` entries.
+uint64_t *packed_list_create(unsigned width, size_t init_cap);
+// Destroys a packed list.
+void packed_list_destroy(uint64_t *list);
+
+// Returns the number of entries in the packed list.
+size_t packed_list_size(const uint64_t *list);
+// Returns the number of bits per entry of the packed list.
+unsigned packed_list_width(const uint64_t *list);
+// Returns the entry at `idx`.
+unsigned packed_list_get(const uint64_t *list, size_t idx);
+// Sets the entry at `idx` to `value`, which must fit in the entry width.
+void packed_list_set(uint64_t *list, size_t idx, unsigned value);
+// Voided pushback method. Pushes `value`, which must fit in the entry width, to the end of the packed list.
+// It is recommended that you use the public facing API `packed_list_push_back(list, value)`.
+void packed_list_vpush_back(uint64_t **list, unsigned value);
+
+//// macros
+
+#define bit_list_new() bit_list_create(64)
+#define bit_list_push_back(bits, value) bit_list_vpush_back(&(bits), value)
+#define bit_list_resize(bits, size) bit_list_vresize(&(bits), size)
+
+#define packed_list_new(width) packed_list_create(width, 64)
+#define packed_list_push_back(list, value) packed_list_vpush_back(&(list), value)
+
+#endif // SNCL_BITLIST_H__
@@ -0,0 +1,93 @@
+/* SNCL Column List v1.00
+   Defines an interface for dynamic struct-of-arrays record lists in C, storing every field in its own column.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_COLUMNLIST_H__
+#define SNCL_COLUMNLIST_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sncl_typeid.h"
+
+// Standard definition for a public column list type, `type` being the row struct
+#define column_list(type) type *
+
+// A column list holds rows of a struct, but stores each declared field of the struct in its own contiguous column
+// instead of storing whole structs back to back. Scanning one field only pulls that field through the cache, and a
+// column is a plain array that loops can vectorize over. All columns share one allocation, each one starting on a
+// 64 byte boundary, and grow together. Column pointers are invalidated whenever the list grows.
+
+// Describes one field of the row struct stored as a column. Use `COLUMN_LIST_FIELD` to fill it in.
+typedef struct {
+    size_t offset; // offset of the field in the row struct
+    size_t size;   // size of the field
+} column_list_field_t;
+
+// Describes `member` of the row struct `type` as a column.
+#define COLUMN_LIST_FIELD(type, member) ((column_list_field_t){ offsetof(type, member), sizeof(((type *)0)->member) })
+
+//// construction
+
+// Creates a column list with one column per field in `fields`, for rows of `row_size` bytes, with room for `init_cap`
+// rows. Fields of the row struct that aren't listed are not stored, and read back as zero bytes.
+// It is recommended that you use `column_list_new` instead.
+void *column_list__create(const column_list_field_t *fields, size_t field_count, size_t row_size, size_t init_cap);
+// Destroys a column list.
+// It is recommended that you use `column_list_destroy` instead.
+void column_list__destroy(void *cl);
+
+//// value stuff
+
+// Returns whether the column list's size is 0 or not.
+bool column_list_empty(void *cl);
+// Returns the number of rows in the column list.
+size_t column_list_size(void *cl);
+// Returns the number of rows the column list can hold before it has to grow.
+size_t column_list_capacity(void *cl);
+// Returns the number of columns.
+size_t column_list_column_count(void *cl);
+// Returns the start of column `col` (in the order the fields were given), holding `column_list_size` entries.
+void *column_list_column(void *cl, size_t col);
+
+// Copies the row at `idx` out into `row`, gathering it from every column.
+// It is recommended that you use `column_list_get_row` instead.
+void column_list__get_row(void *cl, size_t idx, void *row);
+
+//// modification
+
+// Appends `row`, scattering its fields over the columns.
+// It is recommended that you use `column_list_push_row` instead.
+void column_list__push_row(void *cl, const void *row);
+// Overwrites the row at `idx` with `row`.
+// It is recommended that you use `column_list_set_row` instead.
+void column_list__set_row(void *cl, size_t idx, const void *row);
+// Removes the row at `idx` in `O(columns)` by moving the last row into its place. Does not preserve order.
+void column_list_swap_remove(void *cl, size_t idx);
+// Clears the column list, ensuring the size is `0`. Does not deallocate.
+void column_list_clear(void *cl);
+// Ensures the column list can hold at least `cap` rows, growing every column at once.
+void column_list_reserve(void *cl, size_t cap);
+
+//// macros
+
+// Creates a column list of rows of `type`, storing each `COLUMN_LIST_FIELD(type, member)` given as a column.
+#define column_list_new(type, ...)                                                                                     \
+    ((type *)column_list__create((const column_list_field_t[]){ __VA_ARGS__ },                                        \
+                                 sizeof((column_list_field_t[]){ __VA_ARGS__ }) / sizeof(column_list_field_t),        \
+                                 sizeof(type), 16))
+#define column_list_destroy(cl) column_list__destroy((void *)(cl))
+
+// Returns column `col` as a pointer to `type`, which must match the field it stores.
+#define column_list_column_as(cl, col, type) ((type *)column_list_column((void *)(cl), col))
+// Copies the row at `idx` into `row`, which must be an lvalue of the row type.
+#define column_list_get_row(cl, idx, row) column_list__get_row((void *)(cl), idx, &(row))
+// Appends a row. Must be an lvalue.
+#define column_list_push_row(cl, row) column_list__push_row((void *)(cl), &(row))
+// Overwrites the row at `idx`. Must be an lvalue.
+#define column_list_set_row(cl, idx, row) column_list__set_row((void *)(cl), idx, &(row))
+
+#endif // SNCL_COLUMNLIST_H__
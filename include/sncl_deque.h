@@ -0,0 +1,93 @@
+/* SNCL Deque v1.00
+   Defines an interface for dynamic custom-type double ended queues in C, stored in a contiguous ring buffer.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_DEQUE_H__
+#define SNCL_DEQUE_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sncl_typeid.h"
+
+// Standard definition for a public deque type
+#define deque(type) type *
+
+// A deque stores its elements in a power-of-two sized ring buffer (an arraylist's storage), so pushing and popping at
+// either end is `O(1)` and never moves the other elements. Growing doubles the buffer and only moves the part that had
+// wrapped around. Pointers to elements are invalidated whenever the deque grows.
+
+//// construction
+
+// Creates a deque given the type size and initial capacity (rounded up to a power of two).
+// It is recommended that you use `deque_new` instead which allows you to pass the type directly.
+void *deque__create(size_t type_size, size_t init_cap);
+// Destroys a deque, freeing its buffer.
+// It is recommended that you use `deque_destroy` instead.
+void deque__destroy(void *dq);
+
+//// value stuff
+
+// Returns a pointer to the element at the given index, counting from the front.
+// It is recommended that you use `deque_at` instead which returns a copy of the element.
+void *deque__at(void *dq, size_t idx);
+// Returns a pointer to the first element of the deque.
+void *deque__front(void *dq);
+// Returns a pointer to the last element of the deque.
+void *deque__back(void *dq);
+
+// Returns whether the deque's size is 0 or not.
+bool deque_empty(void *dq);
+// Returns the size of the deque.
+size_t deque_size(void *dq);
+// Returns the number of elements the deque can hold before it has to grow.
+size_t deque_capacity(void *dq);
+
+// Returns the elements of the deque, front to back, as at most two contiguous runs: `first` holds `first_count`
+// elements and `second` the `second_count` elements that wrapped around to the start of the buffer. Unused runs are
+// `NULL` with a count of `0`. Pair it with `deque_consume` to process a queue in batches without copying.
+void deque_spans(void *dq, void **first, size_t *first_count, void **second, size_t *second_count);
+
+//// modification
+
+// Pushes a value to the back of the deque, supporting only lvalues, returning where it was stored.
+// It is recommended that you use `deque_push_back` instead.
+void *deque__push_back(void *dq, const void *val);
+// Pushes a value to the front of the deque, supporting only lvalues, returning where it was stored.
+// It is recommended that you use `deque_push_front` instead.
+void *deque__push_front(void *dq, const void *val);
+// Removes the first element of the deque.
+// It is recommended that you use `deque_pop_front` instead which returns a copy of the value.
+void deque__pop_front(void *dq);
+// Removes the last element of the deque.
+// It is recommended that you use `deque_pop_back` instead which returns a copy of the value.
+void deque__pop_back(void *dq);
+// Removes the first `n` elements of the deque (or all of them if there are fewer) in `O(1)`.
+void deque_consume(void *dq, size_t n);
+// Clears the deque, ensuring the size is `0`. Does not shrink the buffer.
+void deque_clear(void *dq);
+// Ensures the deque can hold at least `cap` elements without growing.
+void deque_reserve(void *dq, size_t cap);
+
+//// macros
+
+#define deque_new(type) ((type *)deque__create(sizeof(type), 16))
+#define deque_destroy(dq) deque__destroy((void *)(dq))
+
+#define deque_at(dq, idx) (*((typeof(dq))deque__at((void *)(dq), idx)))
+#define deque_front(dq) (*((typeof(dq))deque__front((void *)(dq))))
+#define deque_back(dq) (*((typeof(dq))deque__back((void *)(dq))))
+
+#define deque_push_back(dq, val) deque__push_back((void *)(dq), &(val))
+#define deque_push_front(dq, val) deque__push_front((void *)(dq), &(val))
+#define deque_pop_front(dq)                                                                                            \
+    deque_front(dq);                                                                                                   \
+    deque__pop_front((void *)(dq))
+#define deque_pop_back(dq)                                                                                             \
+    deque_back(dq);                                                                                                    \
+    deque__pop_back((void *)(dq))
+
+#endif // SNCL_DEQUE_H__
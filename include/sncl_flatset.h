@@ -0,0 +1,87 @@
+/* SNCL Flat Set v1.00
+   Defines sorted flat sets and maps in C, stored as ordinary arraylists kept in order.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_FLATSET_H__
+#define SNCL_FLATSET_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sncl_arraylist.h"
+#include "sncl_typeid.h"
+
+// Standard definition for a public flat set type
+#define flat_set(type) type *
+// Standard definition for a public flat map type, `type` being an entry struct whose first member is the key
+#define flat_map(type) type *
+
+// A flat set is an arraylist whose elements are kept sorted and unique, so every `array_list_*` read (size, at, begin,
+// end, ...) works on it directly and iterating it is a linear scan over contiguous memory. Lookups are a branchless
+// binary search. Every call takes the comparator, with the same contract as the `qsort` comparator, and it must be the
+// same one for the lifetime of the set.
+//
+// A flat map is a flat set of entries whose comparator only looks at the key. As the key is the first member of the
+// entry, lookups can pass a pointer to a bare key in place of an entry.
+
+typedef int (*flat_set_cmp_t)(const void *, const void *);
+
+//// lookup
+
+// Returns the index of the first element that is not less than `key`, or the size of the set if there is none.
+size_t flat_set__lower_bound(void *set, const void *key, flat_set_cmp_t cmp);
+// Returns the index of the first element that is greater than `key`, or the size of the set if there is none.
+size_t flat_set__upper_bound(void *set, const void *key, flat_set_cmp_t cmp);
+// Returns a pointer to the element equal to `key`, or `NULL` if there is none.
+// It is recommended that you use `flat_set_find` instead.
+void *flat_set__find(void *set, const void *key, flat_set_cmp_t cmp);
+
+//// modification
+
+// Inserts `val` into the set in order, returning a pointer to where it was stored. If an equal element already exists
+// nothing is inserted and a pointer to the existing element is returned. `inserted` (which may be `NULL`) reports which.
+// Returns `NULL` if the set's arraylist can't grow (a read-only mapped one).
+// It is recommended that you use `flat_set_insert` instead.
+void *flat_set__insert(void **set, const void *val, flat_set_cmp_t cmp, bool *inserted);
+// Inserts `val` into the set, replacing an equal element if there is one. Returns a pointer to where it was stored.
+// It is recommended that you use `flat_map_put` instead.
+void *flat_set__put(void **set, const void *val, flat_set_cmp_t cmp);
+// Inserts `n` values into the set at once. The batch is sorted, then merged into the set from the back in a single
+// pass, growing it at most once. Elements already in the set win over equal values in the batch, and if the batch holds
+// equal values only one of them is kept. Returns how many elements were inserted.
+// It is recommended that you use `flat_set_insert_n` instead.
+size_t flat_set__insert_n(void **set, const void *vals, size_t n, flat_set_cmp_t cmp);
+// Erases the element equal to `key`. Returns `false` if there is none.
+// It is recommended that you use `flat_set_erase` instead.
+bool flat_set__erase(void *set, const void *key, flat_set_cmp_t cmp);
+// Turns an arraylist into a flat set in place by sorting it and erasing duplicates. Returns how many were erased.
+size_t flat_set__build(void *list, flat_set_cmp_t cmp);
+
+//// macros
+
+#define flat_set_new(type) ((type *)array_list_create(sizeof(type), 16))
+#define flat_set_destroy(set) array_list_destroy((void *)(set))
+
+#define flat_set_lower_bound(set, key, cmp) flat_set__lower_bound((void *)(set), (const void *)(&(key)), cmp)
+#define flat_set_upper_bound(set, key, cmp) flat_set__upper_bound((void *)(set), (const void *)(&(key)), cmp)
+#define flat_set_find(set, key, cmp) ((typeof(set))flat_set__find((void *)(set), (const void *)(&(key)), cmp))
+#define flat_set_contains(set, key, cmp) (flat_set__find((void *)(set), (const void *)(&(key)), cmp) != NULL)
+
+#define flat_set_insert(set, val, cmp) ((typeof(set))flat_set__insert((void **)(&set), (const void *)(&(val)), cmp, NULL))
+#define flat_set_insert_n(set, ptr, n, cmp) flat_set__insert_n((void **)(&set), (const void *)(ptr), n, cmp)
+#define flat_set_erase(set, key, cmp) flat_set__erase((void *)(set), (const void *)(&(key)), cmp)
+
+#define flat_map_new(type) flat_set_new(type)
+#define flat_map_destroy(map) flat_set_destroy(map)
+
+// Returns a pointer to the entry stored under `key`, or `NULL`. `key` must be an lvalue of the key type.
+#define flat_map_get(map, key, cmp) flat_set_find(map, key, cmp)
+// Inserts `entry`, replacing the entry with the same key if there is one. Returns a pointer to the stored entry.
+#define flat_map_put(map, entry, cmp) ((typeof(map))flat_set__put((void **)(&map), (const void *)(&(entry)), cmp))
+#define flat_map_put_n(map, ptr, n, cmp) flat_set_insert_n(map, ptr, n, cmp)
+#define flat_map_erase(map, key, cmp) flat_set_erase(map, key, cmp)
+
+#endif // SNCL_FLATSET_H__
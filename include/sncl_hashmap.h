@@ -0,0 +1,105 @@
+/* SNCL HashMap v1.00
+   Defines an interface for open-addressing custom-type hash maps in C.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_HASHMAP_H__
+#define SNCL_HASHMAP_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sncl_typeid.h"
+
+// Standard definition for a public hash map type. The handle is typed by the value type, so lookups return typed
+// pointers to values, but it is opaque and must never be dereferenced.
+#define hash_map(key_type, value_type) value_type *
+
+// A hash map keeps its entries in one flat array of slots next to an array of one-byte control tags, one per slot.
+// Each tag holds 7 bits of the key's hash (or marks the slot empty or erased), and lookups compare 16 tags at once with
+// SSE2 (or a portable fallback), only touching slots whose tag matches. Pointers to keys and values are invalidated
+// whenever the map grows or is rehashed.
+
+// Hashes a key. Keys are passed as pointers to them, the result is mixed again before use so a weak hash is fine.
+typedef uint64_t (*hash_map_hash_t)(const void *key);
+// Returns whether two keys are equal. Must agree with the hash function.
+typedef bool (*hash_map_eq_t)(const void *a, const void *b);
+
+//// construction
+
+// Creates a hash map given the key and value sizes, the offset of the value and the size of a key/value slot, and its
+// hash and equality callbacks. A `NULL` hash or equality callback hashes or compares the key's bytes.
+// It is recommended that you use `hash_map_new` instead which allows you to pass the types directly.
+void *hash_map__create(size_t key_size, size_t value_size, size_t value_offset, size_t slot_size, hash_map_hash_t hash,
+                       hash_map_eq_t eq);
+// Destroys a hash map, freeing its storage.
+// It is recommended that you use `hash_map_destroy` instead.
+void hash_map__destroy(void *map);
+
+//// value stuff
+
+// Returns a pointer to the value stored under `key`, or `NULL` if there is none.
+// It is recommended that you use `hash_map_get` instead.
+void *hash_map__get(void *map, const void *key);
+// Returns whether the hash map's size is 0 or not.
+bool hash_map_empty(void *map);
+// Returns the number of entries in the hash map.
+size_t hash_map_size(void *map);
+// Returns the number of slots in the hash map.
+size_t hash_map_capacity(void *map);
+
+// Walks the entries of the hash map in no particular order. `cursor` must start at `0`. Every call stores the next
+// entry's key and value pointers (either may be `NULL`) and returns `true`, until there are no entries left.
+bool hash_map__next(void *map, size_t *cursor, void **key, void **value);
+
+//// modification
+
+// Stores `value` under `key`, replacing the value if the key is already present. Returns a pointer to the stored value.
+// It is recommended that you use `hash_map_put` instead.
+void *hash_map__put(void *map, const void *key, const void *value);
+// Finds the slot for `key`, inserting the key with an uninitialized value if it isn't present. Returns a pointer to the
+// value and reports through `inserted` (which may be `NULL`) whether the key was new.
+void *hash_map__emplace(void *map, const void *key, bool *inserted);
+// Erases the entry stored under `key`. Returns `false` if there is none.
+// It is recommended that you use `hash_map_erase` instead.
+bool hash_map__erase(void *map, const void *key);
+// Erases every entry, keeping the slots allocated.
+void hash_map_clear(void *map);
+// Ensures the hash map can hold at least `count` entries without growing.
+void hash_map_reserve(void *map, size_t count);
+// Sets the fraction of slots that may be used before the hash map grows (`0.875` by default). Lower values trade memory
+// for shorter probes. It is clamped to between `0.25` and `0.9375`, and applies from the next insertion, unless the map
+// already holds more entries than the new limit allows, in which case it grows right away.
+void hash_map_set_max_load(void *map, double max_load);
+
+//// helpers
+
+// Hashes `len` bytes, the default hash function.
+uint64_t hash_map_hash_bytes(const void *data, size_t len);
+// Hash and equality callbacks for keys of type `char *` (or `const char *`) comparing the strings they point to.
+uint64_t hash_map_hash_str(const void *key);
+bool hash_map_eq_str(const void *a, const void *b);
+
+//// macros
+
+// The slot layout is a struct of the key followed by the value, so the value gets its natural alignment.
+#define hash_map_new(key_type, value_type, hash, eq)                                                                   \
+    ((value_type *)hash_map__create(sizeof(key_type), sizeof(value_type),                                              \
+                                    offsetof(struct { key_type k_; value_type v_; }, v_),                              \
+                                    sizeof(struct { key_type k_; value_type v_; }), hash, eq))
+#define hash_map_destroy(map) hash_map__destroy((void *)(map))
+
+// Returns a pointer to the value stored under `key` or `NULL`. `key` must be an lvalue.
+#define hash_map_get(map, key) ((typeof(map))hash_map__get((void *)(map), (const void *)(&(key))))
+#define hash_map_contains(map, key) (hash_map__get((void *)(map), (const void *)(&(key))) != NULL)
+// Stores `value` under `key`. Both must be lvalues.
+#define hash_map_put(map, key, value)                                                                                  \
+    ((typeof(map))hash_map__put((void *)(map), (const void *)(&(key)), (const void *)(&(value))))
+// Returns a pointer to the value under `key`, inserting an uninitialized one if it isn't present.
+#define hash_map_emplace(map, key) ((typeof(map))hash_map__emplace((void *)(map), (const void *)(&(key)), NULL))
+#define hash_map_erase(map, key) hash_map__erase((void *)(map), (const void *)(&(key)))
+
+#endif // SNCL_HASHMAP_H__
@@ -0,0 +1,95 @@
+/* SNCL Intrusive List v1.00
+   Defines an interface for intrusive doubly linked lists in C, linking caller-owned objects in place.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_INTRUSIVELIST_H__
+#define SNCL_INTRUSIVELIST_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// An intrusive list never allocates nor copies: the caller embeds an `intrusive_link_t` in their own struct and the
+// list links those fields together. An object can sit on as many lists at once as it has link fields, and
+// `intrusive_list_entry` turns a link back into the object holding it. The list never owns the objects, so they must
+// outlive their membership and destroying an object means removing it from every list first.
+
+// Link field embedded in a linked object. A link is on at most one list at a time.
+typedef struct SNCL_IntrusiveLink {
+    struct SNCL_IntrusiveLink *next;
+    struct SNCL_IntrusiveLink *prev;
+} intrusive_link_t;
+
+// An intrusive list, closed into a ring through the `head` sentinel so linking never needs to check for the ends.
+// Lists may live anywhere, but must not be moved or copied while they hold links.
+typedef struct {
+    intrusive_link_t head;
+    size_t size;
+} intrusive_list_t;
+
+// Returns a pointer to the `type` object whose `member` link field is `link`.
+#define intrusive_list_entry(link, type, member) ((type *)((char *)(link) - offsetof(type, member)))
+
+//// construction
+
+// Initializes an empty list.
+void intrusive_list_init(intrusive_list_t *list);
+// Marks a link as not on any list, for `intrusive_link_is_linked`. Links need no initialization otherwise.
+void intrusive_link_init(intrusive_link_t *link);
+// Returns whether the link is on a list. Only meaningful for links passed to `intrusive_link_init` once before use, as
+// every removal resets them to the same state.
+bool intrusive_link_is_linked(const intrusive_link_t *link);
+
+//// iteration
+
+// Returns the first link of the list, or `NULL` if it is empty.
+intrusive_link_t *intrusive_list_first(intrusive_list_t *list);
+// Returns the last link of the list, or `NULL` if it is empty.
+intrusive_link_t *intrusive_list_last(intrusive_list_t *list);
+// Returns the link after `link`, or `NULL` past the last one.
+intrusive_link_t *intrusive_list_next(intrusive_list_t *list, intrusive_link_t *link);
+// Returns the link before `link`, or `NULL` before the first one.
+intrusive_link_t *intrusive_list_prev(intrusive_list_t *list, intrusive_link_t *link);
+
+//// value stuff
+
+// Returns whether the list holds no links.
+bool intrusive_list_empty(const intrusive_list_t *list);
+// Returns the number of links on the list.
+size_t intrusive_list_size(const intrusive_list_t *list);
+
+// Links `link` at the front of the list.
+void intrusive_list_push_front(intrusive_list_t *list, intrusive_link_t *link);
+// Links `link` at the back of the list.
+void intrusive_list_push_back(intrusive_list_t *list, intrusive_link_t *link);
+// Links `link` right before `pos`, which must be on the list.
+void intrusive_list_insert_before(intrusive_list_t *list, intrusive_link_t *pos, intrusive_link_t *link);
+// Links `link` right after `pos`, which must be on the list.
+void intrusive_list_insert_after(intrusive_list_t *list, intrusive_link_t *pos, intrusive_link_t *link);
+
+// Unlinks `link`, which must be on the list, in `O(1)`.
+void intrusive_list_remove(intrusive_list_t *list, intrusive_link_t *link);
+// Unlinks and returns the first link of the list, or `NULL` if it is empty.
+intrusive_link_t *intrusive_list_pop_front(intrusive_list_t *list);
+// Unlinks and returns the last link of the list, or `NULL` if it is empty.
+intrusive_link_t *intrusive_list_pop_back(intrusive_list_t *list);
+
+// Unlinks every link of the list. Runs in `O(n)` to reset every link for `intrusive_link_is_linked`.
+void intrusive_list_clear(intrusive_list_t *list);
+
+//// macros
+
+// Loops `it` over every link of the list. The current link must not be removed, use `intrusive_list_for_each_safe`.
+#define intrusive_list_for_each(list, it)                                                                              \
+    for (intrusive_link_t *it = intrusive_list_first(list); it; it = intrusive_list_next(list, it))
+// Loops `it` over every link of the list, fetching the next link up front so `it` may be removed inside the loop.
+#define intrusive_list_for_each_safe(list, it, tmp)                                                                    \
+    for (intrusive_link_t *it = intrusive_list_first(list), *tmp = it ? intrusive_list_next(list, it) : NULL; it;     \
+         it = tmp, tmp = it ? intrusive_list_next(list, it) : NULL)
+
+#define intrusive_list_front(list, type, member) intrusive_list_entry(intrusive_list_first(list), type, member)
+#define intrusive_list_back(list, type, member) intrusive_list_entry(intrusive_list_last(list), type, member)
+
+#endif // SNCL_INTRUSIVELIST_H__
@@ -1,4 +1,4 @@
-/* SNCL ArrayList v1.00
+/* SNCL LinkedList v1.04
    Defines an interface for dynamic custom-type linkedlists in C.
 
    Contributors:
@@ -15,11 +15,25 @@
 
 #define linked_list(type) type *
 
+// External iterator over a linkedlist, living wherever the caller puts it. Any number of them may walk a list at once,
+// including from different threads as long as nothing modifies the list meanwhile.
+typedef struct {
+    void *list;
+    void *node;   // `NULL` once the iterator has run off either end
+    bool forward; // which way `linked_list_iter_next` steps
+} linked_list_iter_t;
+
 //// construction
 
 // Creates a linked list given the type's size.
 // It is recommended that you use `linked_list_new` instead which allows you to pass the type directly.
 void *linked_list__create(size_t type_size);
+// Creates a linked list given the type's size, whose nodes come out of a pool owned by the list instead of one
+// allocation each. The pool hands nodes out of contiguous slabs of `slab_nodes` nodes, so neighbouring nodes tend to sit
+// next to each other in memory, and reuses removed nodes before touching a new slab. Clearing a pooled list takes
+// `O(1)` as the slabs are simply reused, and they are only freed when the list is destroyed.
+// It is recommended that you use `linked_list_new_pooled` instead which allows you to pass the type directly.
+void *linked_list__create_pooled(size_t type_size, size_t slab_nodes);
 // Destroys a linked list given its pointer.
 // It is recommended that you use `linked_list_destroy` instead.
 void linked_list__destroy(void *ll);
@@ -46,6 +60,35 @@ iterator_t linked_list_begin(void *ll);
 // Returns `NULL`, an indication that the last element has been reached.
 iterator_t linked_list_end(void *ll);
 
+// Returns an external iterator at the first element, stepping towards the back.
+linked_list_iter_t linked_list_iter_begin(void *ll);
+// Returns an external iterator at the last element, stepping towards the front.
+linked_list_iter_t linked_list_iter_rbegin(void *ll);
+// Returns the element the iterator is at, or `NULL` once it has run off either end.
+// It is recommended that you use `linked_list_iter_at` instead which returns a typed pointer.
+void *linked_list_iter_get(linked_list_iter_t *it);
+// Steps the iterator one element along its direction.
+void linked_list_iter_next(linked_list_iter_t *it);
+// Steps the iterator one element against its direction.
+void linked_list_iter_prev(linked_list_iter_t *it);
+// Removes the element the iterator is at, stepping the iterator on along its direction. Other iterators at the same
+// element are invalidated, those elsewhere stay valid.
+void linked_list_iter_remove(linked_list_iter_t *it);
+// Inserts an element right before the one the iterator is at, in list order whichever way the iterator walks, or at
+// the back once it has run off an end. Supports only lvalues, the iterator stays at the same element.
+// It is recommended that you use `linked_list_iter_insert` instead which will handle converting your value to a
+// pointer for you.
+void linked_list_iter_insert_before(linked_list_iter_t *it, void *val);
+
+// Calls `fn` on every element with index in `[begin, end)`, splitting the range into contiguous chunks walked by up to
+// `threads` threads (`0` uses one per online CPU). Short ranges, and platforms without pthreads, are walked on the
+// calling thread. The calling thread finds where each chunk starts first, which is quick while a positional index is
+// current (see `linked_list_set_index_stride`) and a walk over the range otherwise.
+// It leaves the finger and the index alone, so several threads may walk the same list with it at once as long as
+// nothing modifies the list meanwhile. `fn` may modify the elements it is given but not the list itself.
+void linked_list_for_each_range(void *ll, size_t begin, size_t end, void (*fn)(void *elem, void *ctx), void *ctx,
+                                size_t threads);
+
 //// value stuff
 
 // Returns the element at the front of the linked list.
@@ -55,7 +98,10 @@ void *linked_list__front(void *ll);
 // It is recommended that you use `linked_list_back` instead which returns a copy of the element.
 void *linked_list__back(void *ll);
 // Returns the element at the given index of the linked list.
-// This function runs in `O(n)` complexity, please use an arraylist instead if you need fast random access.
+// The list remembers the last node reached by index (its "finger"), and walks from whichever of the head, the tail or
+// the finger is closest, so stepping through the indices in order runs in `O(1)` per call. Jumping around still runs in
+// `O(n)` unless an index is enabled with `linked_list_set_index_stride`, and an arraylist remains faster in both cases.
+// As it moves the finger, it must not be called from several threads at once, use external iterators for that.
 // It is recommended that you use `linked_list_at` instead which returns a copy of the element.
 void *linked_list__get(void *ll, size_t offset);
 
@@ -63,13 +109,20 @@ void *linked_list__get(void *ll, size_t offset);
 bool linked_list_empty(void *ll);
 // Returns the size of the linkedlist
 size_t linked_list_size(void *ll);
+// Returns whether the linkedlist allocates its nodes from a pool.
+bool linked_list_is_pooled(void *ll);
+// Enables a positional index holding every `stride`-th node, or disables it when `stride` is `0`. With the index in
+// place, any positional access walks at most `stride / 2` nodes. Pushing and popping at the back keeps the index up to
+// date, while any other insertion or removal leaves it stale until enough walking has been done to pay for rebuilding
+// it in `O(n)`. A stride around the square root of the list's size is a good default.
+void linked_list_set_index_stride(void *ll, size_t stride);
 
 // Clears the linkedlist, freeing all nodes and setting the size to 0.
-// This fuction runs in `O(n)` complexity, please use an arraylist instead if you need fast cleanup.
+// This fuction runs in `O(n)` complexity, please use an arraylist or a pooled linkedlist if you need fast cleanup.
 void linked_list_clear(void *ll);
 
 // Adds an element to the linkedlist, supporting only lvalues (sorry).
-// This function runs in `O(n)` complexity.
+// This function walks to `pos` like `linked_list__get` does.
 // It is recommended that you use `linked_list_add` instead which will handle converting your value to a pointer for
 // you.
 void linked_list__add(void *ll, size_t pos, void *val);
@@ -83,7 +136,8 @@ void linked_list__push_front(void *ll, void *val);
 void linked_list__push_back(void *ll, void *val);
 
 // Removes an element from the linkedlist given it's position.
-// This function runs in `O(2n)` complexity, it is recommended you opt to use the internal iterators for removal.
+// This function walks to `offset` like `linked_list__get` does, it is recommended you opt to use the internal iterators
+// for removal.
 // It is recommended that you use `linked_list_remove` instead which returns a copy of the value.
 void linked_list__remove(void *ll, size_t offset);
 // Removes the first element from the linkedlist and returns it.
@@ -93,10 +147,31 @@ void linked_list__pop_front(void *ll);
 // It is recommended that you use `linked_list_pop_back` instead which returns a copy of the value.
 void linked_list__pop_back(void *ll);
 
+//// moving between lists
+
+// Moves every element of `src` into `dst` in front of position `pos`, leaving `src` empty. The nodes are relinked
+// without copying in `O(1)` after walking to `pos`, unless either list is pooled, in which case every element is copied
+// into `dst` in `O(n)` as a node can only go back to the pool it came from. Both lists must hold the same type.
+// Copies are all made before anything leaves `src`, so if one can't be allocated both lists are left unchanged.
+void linked_list_splice(void *dst, size_t pos, void *src);
+// Moves every element of `src` to the back of `dst`, leaving `src` empty, in `O(1)` for lists that are not pooled.
+void linked_list_concat(void *dst, void *src);
+// Splits the list at `pos`, moving the elements from `pos` onwards into a new list which is returned (`NULL` if `pos`
+// is past the end or the elements couldn't be copied). The new list is pooled like the original, and elements are only
+// copied if it is pooled.
+// It is recommended that you use `linked_list_split_at` instead which returns the list typed like the original.
+void *linked_list__split_at(void *ll, size_t pos);
+// Moves the elements with index in `[begin, end)` out of `src` and into `dst` in front of position `pos`, walking to
+// both ends of the range and relinking it as a whole unless either list is pooled. `src` and `dst` must be different
+// lists holding the same type.
+void linked_list_move_range(void *dst, size_t pos, void *src, size_t begin, size_t end);
+
 //// macros
 
 #define linked_list_new(type) ((type *)linked_list__create(sizeof(type)))
+#define linked_list_new_pooled(type, slab_nodes) ((type *)linked_list__create_pooled(sizeof(type), slab_nodes))
 #define linked_list_destroy(ll) linked_list__destroy((void *)(ll))
+#define linked_list_split_at(ll, pos) ((typeof(ll))linked_list__split_at((void *)(ll), pos))
 
 #define linked_list_start(ll) linked_list__start((void *)(ll));
 #define linked_list_rstart(ll) linked_list__rstart((void *)(ll));
@@ -106,6 +181,9 @@ void linked_list__pop_back(void *ll);
 #define linked_list_back(ll) (*((typeof(ll))(linked_list__back((void *)(ll)))))
 #define linked_list_at(ll, idx) (*((typeof(ll))(linked_list__get((void *)(ll), idx))))
 
+#define linked_list_iter_at(ll, it) ((typeof(ll))linked_list_iter_get(it))
+#define linked_list_iter_insert(it, val) linked_list_iter_insert_before(it, &(val))
+
 #define linked_list_add(ll, idx, val) linked_list__add((void *)(ll), idx, &(val))
 #define linked_list_push_front(ll, val) linked_list__push_front((void *)(ll), &(val))
 #define linked_list_push_back(ll, val) linked_list__push_back((void *)(ll), &(val))
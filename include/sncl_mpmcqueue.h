@@ -0,0 +1,77 @@
+/* SNCL MPMC Queue v1.00
+   Defines an interface for lock-free multi-producer multi-consumer queues in C.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_MPMCQUEUE_H__
+#define SNCL_MPMCQUEUE_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sncl_typeid.h"
+
+// Standard definition for a public mpmc queue type
+#define mpmc_queue(type) type *
+
+// An MPMC queue is a Michael-Scott queue: a singly linked list of linkedlist-style nodes with a dummy node at the head,
+// where producers link new nodes at the tail and consumers swing the head forward, each with a single compare and swap
+// and without ever taking a lock.
+// Every thread using the queue first attaches to it to get a handle, which holds the thread's hazard pointers, the
+// nodes it has unlinked but that other threads may still be reading, and a cache of free nodes. Unlinked nodes are only
+// reused once no hazard pointer names them, and cached nodes move between threads in batches through a shared pool, so
+// a steady stream of pushes and pops stops allocating once the caches are warm. Nodes are only freed on destroy.
+
+// Per-thread handle into a queue, obtained from `mpmc_queue_attach`.
+typedef struct SNCL_MQHandle mpmc_queue_handle_t;
+
+// Passed as the timeout to `mpmc_queue_pop_wait` to wait for as long as it takes.
+#define MPMC_QUEUE_WAIT_FOREVER (-1L)
+
+//// construction
+
+// Creates a queue given the type's size and the most threads that will be attached to it at once.
+// It is recommended that you use `mpmc_queue_new` instead which allows you to pass the type directly.
+void *mpmc_queue__create(size_t type_size, size_t max_threads);
+// Destroys a queue, freeing every node. No thread may be using the queue anymore.
+// It is recommended that you use `mpmc_queue_destroy` instead.
+void mpmc_queue__destroy(void *q);
+
+// Attaches the calling thread to the queue, returning its handle, or `NULL` if `max_threads` handles are in use.
+// A handle must only be used by one thread at a time.
+mpmc_queue_handle_t *mpmc_queue_attach(void *q);
+// Gives a handle back to the queue. Its cached nodes stay with it for whichever thread attaches next.
+void mpmc_queue_detach(void *q, mpmc_queue_handle_t *h);
+
+//// value stuff
+
+// Pushes a copy of the value pointed to by `val` to the back of the queue, waking a thread blocked in
+// `mpmc_queue_pop_wait` if there is one.
+// It is recommended that you use `mpmc_queue_push` instead.
+void mpmc_queue__push(void *q, mpmc_queue_handle_t *h, const void *val);
+// Pops the value at the front of the queue into `out`, returning `false` without waiting (and without touching `out`)
+// if the queue is empty.
+// It is recommended that you use `mpmc_queue_pop` instead.
+bool mpmc_queue__pop(void *q, mpmc_queue_handle_t *h, void *out);
+// Pops the value at the front of the queue into `out`, blocking for up to `timeout_ms` milliseconds (or forever with
+// `MPMC_QUEUE_WAIT_FOREVER`) while the queue is empty. Returns `false` if the wait timed out.
+// Blocked threads sleep on a futex on Linux and poll with short sleeps elsewhere.
+// It is recommended that you use `mpmc_queue_pop_wait` instead.
+bool mpmc_queue__pop_wait(void *q, mpmc_queue_handle_t *h, void *out, long timeout_ms);
+
+// Returns whether the queue was empty at some point during the call.
+bool mpmc_queue_empty(void *q, mpmc_queue_handle_t *h);
+
+//// macros
+
+#define mpmc_queue_new(type, max_threads) ((type *)mpmc_queue__create(sizeof(type), max_threads))
+#define mpmc_queue_destroy(q) mpmc_queue__destroy((void *)(q))
+
+#define mpmc_queue_push(q, h, val) mpmc_queue__push((void *)(q), h, &(val))
+// Pops into `out`, which must be an lvalue of the queue's type.
+#define mpmc_queue_pop(q, h, out) mpmc_queue__pop((void *)(q), h, &(out))
+#define mpmc_queue_pop_wait(q, h, out, timeout_ms) mpmc_queue__pop_wait((void *)(q), h, &(out), timeout_ms)
+
+#endif // SNCL_MPMCQUEUE_H__
@@ -0,0 +1,99 @@
+/* SNCL Segmented List v1.02
+   Defines an interface for dynamic custom-type segmented arrays in C, which never move elements once pushed.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_SEGLIST_H__
+#define SNCL_SEGLIST_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sncl_typeid.h"
+
+// Standard definition for a public segmented list type
+#define seg_list(type) type *
+
+// A segmented list stores its elements in segments of power-of-two sizes, each twice as big as the one before it.
+// Growing only ever allocates a new segment, so existing elements are never copied and pointers to them stay valid
+// until they are popped, cleared or the list is destroyed. Indexing is still `O(1)`.
+
+//// construction
+
+// Creates a segmented list given the type size and the size of its first segment (rounded up to a power of two).
+// It is recommended that you use `seg_list_new` instead which allows you to pass the type directly.
+void *seg_list__create(size_t type_size, size_t first_segment);
+// Destroys a segmented list, freeing every segment.
+// It is recommended that you use `seg_list_destroy` instead.
+void seg_list__destroy(void *sl);
+
+//// value stuff
+
+// Returns a pointer to the element at the given index.
+// It is recommended that you use `seg_list_at` instead which returns a copy of the element.
+void *seg_list__at(void *sl, size_t idx);
+// Returns a pointer to the first element of the segmented list.
+void *seg_list__front(void *sl);
+// Returns a pointer to the last element of the segmented list.
+void *seg_list__back(void *sl);
+
+// Returns whether the segmented list's size is 0 or not.
+bool seg_list_empty(void *sl);
+// Returns the size of the segmented list.
+size_t seg_list_size(void *sl);
+// Returns the number of elements the segmented list can hold before it allocates another segment.
+size_t seg_list_capacity(void *sl);
+
+// Returns the number of segments that currently hold elements.
+size_t seg_list_segment_count(void *sl);
+// Returns the start of segment `k` and stores how many elements are in use there in `count`, so contiguous runs can be
+// walked without indexing element by element.
+void *seg_list_segment(void *sl, size_t k, size_t *count);
+
+//// modification
+
+// Pushes a value to the end of the segmented list, supporting only lvalues, returning where it was stored.
+// It is recommended that you use `seg_list_push_back` instead.
+void *seg_list__push_back(void *sl, const void *val);
+// Removes the last element of the segmented list. Its segment is kept around for the next push.
+// It is recommended that you use `seg_list_pop_back` instead which returns a copy of the value.
+void seg_list__pop_back(void *sl);
+// Clears the segmented list, ensuring the size is `0`. Segments are kept around for reuse.
+void seg_list_clear(void *sl);
+// Ensures the segmented list can hold at least `cap` elements without allocating.
+void seg_list_reserve(void *sl, size_t cap);
+
+//// concurrent appends
+
+// Pushes a value to the end of the segmented list from any number of threads at once, returning where it was stored.
+// Each call claims its index with an atomic add, copies the value in and marks its slot written without holding a lock,
+// and a missing segment is allocated by whichever thread needs it first. Producers never wait on each other: the value
+// becomes visible through `seg_list_published` once every index before it is written too, whichever producer (or
+// reader) sees that first moves the published length forward. Every slot costs one extra bit for its written mark.
+// Reserving capacity up front keeps allocations out of the producers entirely.
+// While concurrent pushes are running, the only other safe calls are `seg_list_published` and `seg_list__at` (or
+// `seg_list_at`) on published indices, everything else must wait until the producers are done.
+// It is recommended that you use `seg_list_push_back_concurrent` instead.
+void *seg_list__push_back_concurrent(void *sl, const void *val);
+// Returns how many elements from the front are fully written and safe to read while concurrent pushes are running.
+// Outside of concurrent pushes it is the same as the size.
+size_t seg_list_published(void *sl);
+
+//// macros
+
+#define seg_list_new(type) ((type *)seg_list__create(sizeof(type), 16))
+#define seg_list_destroy(sl) seg_list__destroy((void *)(sl))
+
+#define seg_list_at(sl, idx) (*((typeof(sl))seg_list__at((void *)(sl), idx)))
+#define seg_list_front(sl) (*((typeof(sl))seg_list__front((void *)(sl))))
+#define seg_list_back(sl) (*((typeof(sl))seg_list__back((void *)(sl))))
+
+#define seg_list_push_back(sl, val) seg_list__push_back((void *)(sl), &(val))
+#define seg_list_push_back_concurrent(sl, val) seg_list__push_back_concurrent((void *)(sl), &(val))
+#define seg_list_pop_back(sl)                                                                                          \
+    seg_list_back(sl);                                                                                                 \
+    seg_list__pop_back((void *)(sl))
+
+#endif // SNCL_SEGLIST_H__
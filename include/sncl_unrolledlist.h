@@ -0,0 +1,119 @@
+/* SNCL Unrolled List v1.00
+   Defines an interface for dynamic custom-type unrolled linkedlists in C, packing several elements into every node.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_UNROLLEDLIST_H__
+#define SNCL_UNROLLEDLIST_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sncl_typeid.h"
+
+// Standard definition for a public unrolled list type
+#define unrolled_list(type) type *
+
+// An unrolled list is a doubly linked list of nodes that each hold up to a fixed number of elements in a small array.
+// Pushing into a full node allocates a new one, inserting into a full node splits it in half, and removing merges a
+// node into its neighbour once both fit in one. Walking the list touches one node per many elements, so traversal and
+// indexing run several times faster than a linkedlist while insertion and removal stay local to a node.
+// Pointers to elements are invalidated by any insertion or removal in the same node, and the internal iterator should
+// be restarted after any insertion or removal.
+
+//// construction
+
+// Creates an unrolled list given the type's size and how many elements each node holds (`0` picks a count that makes
+// the elements of a node take up about four cache lines).
+// It is recommended that you use `unrolled_list_new` instead which allows you to pass the type directly.
+void *unrolled_list__create(size_t type_size, size_t node_capacity);
+// Destroys an unrolled list given its pointer.
+// It is recommended that you use `unrolled_list_destroy` instead.
+void unrolled_list__destroy(void *ul);
+
+//// iterators
+
+// Starts the internal iterator of the unrolled list at the first element.
+// It is recommended that you use `unrolled_list_start` instead.
+void unrolled_list__start(void *ul);
+// Starts the internal iterator of the unrolled list at the last element.
+// It is recommended that you use `unrolled_list_rstart` instead.
+void unrolled_list__rstart(void *ul);
+// Shifts the internal iterator of the unrolled list once, returning the value once stored by the iterator, or `NULL`
+// once it has run off the end.
+// It is recommended that you use `unrolled_list_next` instead which returns a copy of the value.
+void *unrolled_list__next(void *ul);
+
+//// value stuff
+
+// Returns the element at the front of the unrolled list.
+// It is recommended that you use `unrolled_list_front` instead which returns a copy of the element.
+void *unrolled_list__front(void *ul);
+// Returns the element at the back of the unrolled list.
+// It is recommended that you use `unrolled_list_back` instead which returns a copy of the element.
+void *unrolled_list__back(void *ul);
+// Returns the element at the given index of the unrolled list, walking whole nodes from the nearest of either end and
+// the node reached by the last positional access, so stepping through the indices in order runs in `O(1)` per call.
+// It is recommended that you use `unrolled_list_at` instead which returns a copy of the element.
+void *unrolled_list__get(void *ul, size_t offset);
+
+// Returns whether the unrolled list's size is 0 or not.
+bool unrolled_list_empty(void *ul);
+// Returns the size of the unrolled list.
+size_t unrolled_list_size(void *ul);
+// Returns the number of nodes in the unrolled list.
+size_t unrolled_list_node_count(void *ul);
+
+// Clears the unrolled list, freeing all nodes and setting the size to 0.
+void unrolled_list_clear(void *ul);
+
+// Adds an element at the given position of the unrolled list, supporting only lvalues.
+// It is recommended that you use `unrolled_list_add` instead.
+void unrolled_list__add(void *ul, size_t pos, void *val);
+// Pushes an element to the front of the unrolled list, supporting only lvalues.
+// It is recommended that you use `unrolled_list_push_front` instead.
+void unrolled_list__push_front(void *ul, void *val);
+// Pushes an element to the back of the unrolled list, supporting only lvalues.
+// It is recommended that you use `unrolled_list_push_back` instead.
+void unrolled_list__push_back(void *ul, void *val);
+
+// Removes an element from the unrolled list given its position.
+// It is recommended that you use `unrolled_list_remove` instead which returns a copy of the value.
+void unrolled_list__remove(void *ul, size_t offset);
+// Removes the first element from the unrolled list.
+// It is recommended that you use `unrolled_list_pop_front` instead which returns a copy of the value.
+void unrolled_list__pop_front(void *ul);
+// Removes the last element from the unrolled list.
+// It is recommended that you use `unrolled_list_pop_back` instead which returns a copy of the value.
+void unrolled_list__pop_back(void *ul);
+
+//// macros
+
+#define unrolled_list_new(type) ((type *)unrolled_list__create(sizeof(type), 0))
+#define unrolled_list_destroy(ul) unrolled_list__destroy((void *)(ul))
+
+#define unrolled_list_start(ul) unrolled_list__start((void *)(ul))
+#define unrolled_list_rstart(ul) unrolled_list__rstart((void *)(ul))
+#define unrolled_list_next(ul) (*((typeof(ul))(unrolled_list__next((void *)(ul)))))
+
+#define unrolled_list_front(ul) (*((typeof(ul))(unrolled_list__front((void *)(ul)))))
+#define unrolled_list_back(ul) (*((typeof(ul))(unrolled_list__back((void *)(ul)))))
+#define unrolled_list_at(ul, idx) (*((typeof(ul))(unrolled_list__get((void *)(ul), idx))))
+
+#define unrolled_list_add(ul, idx, val) unrolled_list__add((void *)(ul), idx, &(val))
+#define unrolled_list_push_front(ul, val) unrolled_list__push_front((void *)(ul), &(val))
+#define unrolled_list_push_back(ul, val) unrolled_list__push_back((void *)(ul), &(val))
+
+#define unrolled_list_remove(ul, idx)                                                                                  \
+    unrolled_list_at(ul, idx);                                                                                         \
+    unrolled_list__remove((void *)(ul), idx)
+#define unrolled_list_pop_front(ul)                                                                                    \
+    unrolled_list_front(ul);                                                                                           \
+    unrolled_list__pop_front((void *)(ul))
+#define unrolled_list_pop_back(ul)                                                                                     \
+    unrolled_list_back(ul);                                                                                            \
+    unrolled_list__pop_back((void *)(ul))
+
+#endif // SNCL_UNROLLEDLIST_H__
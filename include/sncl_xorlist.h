@@ -0,0 +1,109 @@
+/* SNCL XOR List v1.00
+   Defines an interface for dynamic custom-type XOR-linked lists in C, storing a single link per node.
+
+   Contributors:
+   - StarIitNova (fynotix.dev@gmail.com)
+ */
+
+#ifndef SNCL_XORLIST_H__
+#define SNCL_XORLIST_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sncl_typeid.h"
+
+// Standard definition for a public xor list type
+#define xor_list(type) type *
+
+// A XOR list is a doubly linked list whose nodes store `prev ^ next` in a single link instead of both pointers, which
+// can be walked either way given the node it was entered from. Nodes are carved out of slabs owned by the list and are
+// only padded to the element's own alignment, so an 8-byte element costs 16 bytes of memory against 32 for a
+// linkedlist node, pooled or not.
+// In exchange there is no positional access nor any way to step from a bare element pointer, every walk has to start
+// from one of the ends through an iterator.
+
+// Iterator over a XOR list, holding the node it is at and the node it came from. It may be copied freely, and any
+// number of them can walk the same list while it is not modified.
+typedef struct {
+    void *prev;
+    void *curr;
+} xor_list_iter_t;
+
+//// construction
+
+// Creates a XOR list given the type's size.
+// It is recommended that you use `xor_list_new` instead which allows you to pass the type directly.
+void *xor_list__create(size_t type_size);
+// Destroys a XOR list given its pointer, freeing every slab.
+// It is recommended that you use `xor_list_destroy` instead.
+void xor_list__destroy(void *xl);
+
+//// iterators
+
+// Returns an iterator at the first element, walking towards the back.
+xor_list_iter_t xor_list_begin(void *xl);
+// Returns an iterator at the last element, walking towards the front.
+xor_list_iter_t xor_list_rbegin(void *xl);
+// Returns the element the iterator is at, or `NULL` once it has run off the end.
+// It is recommended that you use `xor_list_iter_at` instead which returns a typed pointer.
+void *xor_list_iter_get(void *xl, xor_list_iter_t *it);
+// Moves the iterator one element along in its direction. Does nothing once it has run off the end.
+void xor_list_iter_next(void *xl, xor_list_iter_t *it);
+// Removes the element the iterator is at, moving the iterator on to the following element.
+// Every other iterator into the list is invalidated.
+void xor_list_iter_remove(void *xl, xor_list_iter_t *it);
+
+//// value stuff
+
+// Returns the element at the front of the XOR list.
+// It is recommended that you use `xor_list_front` instead which returns a copy of the element.
+void *xor_list__front(void *xl);
+// Returns the element at the back of the XOR list.
+// It is recommended that you use `xor_list_back` instead which returns a copy of the element.
+void *xor_list__back(void *xl);
+
+// Returns whether the XOR list's size is 0 or not.
+bool xor_list_empty(void *xl);
+// Returns the size of the XOR list.
+size_t xor_list_size(void *xl);
+// Returns how many bytes the XOR list holds on to, including its slabs and its own header.
+size_t xor_list_memory_usage(void *xl);
+
+// Clears the XOR list in `O(1)`, keeping its slabs for reuse.
+void xor_list_clear(void *xl);
+
+// Pushes an element to the front of the XOR list, supporting only lvalues.
+// It is recommended that you use `xor_list_push_front` instead.
+void xor_list__push_front(void *xl, void *val);
+// Pushes an element to the back of the XOR list, supporting only lvalues.
+// It is recommended that you use `xor_list_push_back` instead.
+void xor_list__push_back(void *xl, void *val);
+// Removes the first element from the XOR list.
+// It is recommended that you use `xor_list_pop_front` instead which returns a copy of the value.
+void xor_list__pop_front(void *xl);
+// Removes the last element from the XOR list.
+// It is recommended that you use `xor_list_pop_back` instead which returns a copy of the value.
+void xor_list__pop_back(void *xl);
+
+//// macros
+
+#define xor_list_new(type) ((type *)xor_list__create(sizeof(type)))
+#define xor_list_destroy(xl) xor_list__destroy((void *)(xl))
+
+#define xor_list_front(xl) (*((typeof(xl))(xor_list__front((void *)(xl)))))
+#define xor_list_back(xl) (*((typeof(xl))(xor_list__back((void *)(xl)))))
+// Returns a pointer to the element the iterator is at, typed like the list.
+#define xor_list_iter_at(xl, it) ((typeof(xl))xor_list_iter_get((void *)(xl), it))
+
+#define xor_list_push_front(xl, val) xor_list__push_front((void *)(xl), &(val))
+#define xor_list_push_back(xl, val) xor_list__push_back((void *)(xl), &(val))
+
+#define xor_list_pop_front(xl)                                                                                         \
+    xor_list_front(xl);                                                                                                \
+    xor_list__pop_front((void *)(xl))
+#define xor_list_pop_back(xl)                                                                                          \
+    xor_list_back(xl);                                                                                                 \
+    xor_list__pop_back((void *)(xl))
+
+#endif // SNCL_XORLIST_H__
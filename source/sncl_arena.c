@@ -0,0 +1,157 @@
+#include <sncl_arena.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// `max_align_t` is C11, so stand in for it here
+typedef union {
+    long double ld;
+    long long ll;
+    void *ptr;
+    void (*fn)(void);
+} arena_align_t;
+
+#define ARENA_DEFAULT_BLOCK_SIZE ((size_t)64 * 1024)
+// `align_up` needs a power of two, which `sizeof(arena_align_t)` is not everywhere (`long double` is 12 bytes on i386)
+#define ARENA_ALIGN (sizeof(arena_align_t) <= 8 ? (size_t)8 : sizeof(arena_align_t) <= 16 ? (size_t)16 : (size_t)32)
+#define align_up(v, a) (((v) + ((a) - 1)) & ~((a) - 1))
+
+typedef struct arena_block {
+    struct arena_block *next;
+    size_t capacity;
+    size_t used;
+    size_t last; // offset of the most recent allocation, for in-place realloc
+    arena_align_t data[];
+} arena_block_t;
+
+struct sncl_arena {
+    sncl_allocator_t allocator;
+
+    arena_block_t *first;
+    arena_block_t *current;
+
+    size_t block_size;
+    size_t reserved;
+};
+
+static void *arena_vtable_alloc(void *ctx, size_t size);
+static void *arena_vtable_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size);
+static void arena_vtable_free(void *ctx, void *ptr, size_t size);
+
+static arena_block_t *new_block(sncl_arena_t *arena, size_t min_size);
+
+sncl_arena_t *sncl_arena_create(size_t block_size) {
+    sncl_arena_t *arena = (sncl_arena_t *)malloc(sizeof(sncl_arena_t));
+    if (!arena)
+        return NULL;
+
+    arena->allocator.alloc = arena_vtable_alloc;
+    arena->allocator.realloc = arena_vtable_realloc;
+    arena->allocator.free = arena_vtable_free;
+    arena->allocator.ctx = arena;
+
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->block_size = block_size ? align_up(block_size, ARENA_ALIGN) : ARENA_DEFAULT_BLOCK_SIZE;
+    arena->reserved = 0;
+    return arena;
+}
+
+void sncl_arena_destroy(sncl_arena_t *arena) {
+    arena_block_t *curr = arena->first;
+    while (curr) {
+        arena_block_t *next = curr->next;
+        free(curr);
+        curr = next;
+    }
+    free(arena);
+}
+
+void *sncl_arena_alloc(sncl_arena_t *arena, size_t size) {
+    size = align_up(size ? size : 1, ARENA_ALIGN);
+
+    arena_block_t *block = arena->current;
+    // reuse blocks kept around by a reset before asking the heap for more
+    while (block && block->capacity - block->used < size) {
+        block = block->next;
+        if (block)
+            block->used = 0;
+    }
+
+    if (!block) {
+        block = new_block(arena, size);
+        if (!block)
+            return NULL;
+    }
+
+    arena->current = block;
+    block->last = block->used;
+    block->used += size;
+    return (uint8_t *)block->data + block->last;
+}
+
+void *sncl_arena_realloc(sncl_arena_t *arena, void *ptr, size_t old_size, size_t new_size) {
+    if (!ptr)
+        return sncl_arena_alloc(arena, new_size);
+
+    arena_block_t *block = arena->current;
+    if (block && (uint8_t *)ptr == (uint8_t *)block->data + block->last) {
+        size_t wanted = align_up(new_size ? new_size : 1, ARENA_ALIGN);
+        if (block->capacity - block->last >= wanted) {
+            block->used = block->last + wanted;
+            return ptr;
+        }
+    }
+
+    if (new_size <= old_size)
+        return ptr;
+
+    void *moved = sncl_arena_alloc(arena, new_size);
+    if (!moved)
+        return NULL;
+    memcpy(moved, ptr, old_size);
+    return moved;
+}
+
+void sncl_arena_reset(sncl_arena_t *arena) {
+    arena->current = arena->first;
+    if (arena->first)
+        arena->first->used = 0;
+}
+
+size_t sncl_arena_reserved(sncl_arena_t *arena) { return arena->reserved; }
+
+const sncl_allocator_t *sncl_arena_allocator(sncl_arena_t *arena) { return &arena->allocator; }
+
+static arena_block_t *new_block(sncl_arena_t *arena, size_t min_size) {
+    size_t capacity = min_size > arena->block_size ? min_size : arena->block_size;
+    arena_block_t *block = (arena_block_t *)malloc(sizeof(arena_block_t) + capacity);
+    if (!block)
+        return NULL;
+
+    block->capacity = capacity;
+    block->used = 0;
+    block->last = 0;
+
+    // splice in after the current block so blocks kept from a previous reset stay reachable
+    if (arena->current) {
+        block->next = arena->current->next;
+        arena->current->next = block;
+    } else {
+        block->next = arena->first;
+        arena->first = block;
+    }
+
+    arena->reserved += capacity;
+    return block;
+}
+
+static void *arena_vtable_alloc(void *ctx, size_t size) { return sncl_arena_alloc((sncl_arena_t *)ctx, size); }
+
+static void *arena_vtable_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    return sncl_arena_realloc((sncl_arena_t *)ctx, ptr, old_size, new_size);
+}
+
+static void arena_vtable_free(__attribute__((unused)) void *ctx, __attribute__((unused)) void *ptr,
+                              __attribute__((unused)) size_t size) {}
@@ -1,31 +1,149 @@
+// mremap is a Linux extension, and a strict C99 build hides the POSIX mapping calls otherwise
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include <sncl_arraylist.h>
 
 #include <assert.h>
+#include <errno.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ARRAY_LIST_MAPPED
+#endif
+
+// the layout lives in the public header so `SNCL_ARRAYLIST_DEFINE` can inline against it
+typedef array_list_header_t array_list_t;
+
+#define ARRAY_LIST_PAGE_SIZE ((size_t)4096)
+
+// slack allocated in front of the header so `data` can always be moved onto an aligned address
+#define align_slack(alignment) ((alignment) > 1 ? (alignment) - 1 : 0)
+#define block_size(alignment, type_size, cap) (align_slack(alignment) + sizeof(array_list_t) + (type_size) * (cap))
+#define block_of(arr) ((uint8_t *)(arr) - (arr)->padding)
+
+static void *create(size_t type_size, size_t init_cap, size_t alignment, const sncl_allocator_t *allocator);
+static size_t data_padding(uint8_t *block, size_t alignment);
+
+static size_t grow_capacity(array_list_t *arr, size_t needed);
+static bool resize(void **list, size_t cap);
+
+// Mapped lists share their header with the file, so the header is tagged with this address instead of a pointer into
+// the process. The process-local state lives at the end of a private page mapped right in front of the file.
+#define MAPPED_ALLOCATOR ((const sncl_allocator_t *)(uintptr_t)2)
+#define is_mapped(arr) ((arr)->allocator == MAPPED_ALLOCATOR)
+
+#ifdef ARRAY_LIST_MAPPED
+typedef struct {
+    int fd;
+    bool read_only;
+    bool length_stale; // a failed resize left the file longer than the mapping, fixed up by the next flush
+} mapped_ctx_t;
+
+#define mapped_ctx_of(block) (((mapped_ctx_t **)(block))[-1])
+
+static size_t mapped_guard_size(void);
+static uint8_t *mapped_map(int fd, size_t length, int flags, void *old, size_t old_length);
+static void *mapped_realloc(mapped_ctx_t *m, void *ptr, size_t old_size, size_t new_size);
+static void mapped_free(mapped_ctx_t *m, void *ptr, size_t size);
+#endif
+
+// Inline lists are tagged with this allocator. Growing out of the caller's buffer copies the list to the heap, after
+// which it is an ordinary heap list. Freeing is a no-op as the buffer belongs to the caller.
+static void *inline_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size);
+static void inline_free(void *ctx, void *ptr, size_t size);
+static const sncl_allocator_t inline_storage = { NULL, inline_realloc, inline_free, NULL };
+
+// Views returned by `array_list_read_view` live in a caller's (usually read-only) buffer that was written to disk, so
+// their header can't point at a real allocator. They are tagged with this address instead, which is the same in every
+// process. Views never grow and destroying one is a no-op.
+#define VIEW_ALLOCATOR ((const sncl_allocator_t *)(uintptr_t)1)
+#define is_view(arr) ((arr)->allocator == VIEW_ALLOCATOR)
+
+// On-disk layout written by `array_list_write`: this header, zero padding, then an `array_list_t` tagged as a view
+// directly followed by the elements at `data_offset`. Fields are in the writer's byte order, recorded by `endian`.
+#define DISK_MAGIC "SNCLLIST"
+#define DISK_VERSION 1u
+#define DISK_ENDIAN 0x01020304u
+#define DISK_ALIGNMENT ((size_t)64)
+
 typedef struct {
-    size_t type_size;
-    size_t capacity;
-    size_t size;
-    uint8_t data[];
-} array_list_t;
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;
+    uint32_t word_size;   // `sizeof(size_t)` of the writer
+    uint32_t header_size; // `sizeof(array_list_t)` of the writer
+    uint64_t alignment;   // the element data is aligned to this many bytes from the start of the file
+    uint64_t data_offset;
+    uint64_t type_size;
+    uint64_t size;
+} disk_header_t;
+
+// the public header promises inline storage of `ARRAY_LIST_HEADER_SIZE` bytes covers the header
+typedef char header_size_check[sizeof(array_list_t) <= ARRAY_LIST_HEADER_SIZE ? 1 : -1];
+
+static void *list_alloc(const sncl_allocator_t *allocator, size_t size);
+static void *list_realloc(const sncl_allocator_t *allocator, void *ptr, size_t old_size, size_t new_size);
+static void list_free(const sncl_allocator_t *allocator, void *ptr, size_t size);
 
 array_list_t *retrieve_from_data(void *data_ptr) { return (array_list_t *)(data_ptr - offsetof(array_list_t, data)); }
 
-void *array_list_create(size_t type_size, size_t init_cap) {
-    array_list_t *list = (array_list_t *)malloc(sizeof(array_list_t) + type_size * init_cap);
-    assert(list != NULL && "failed to allocate array list when instantiating");
+void *array_list_create(size_t type_size, size_t init_cap) { return create(type_size, init_cap, 0, NULL); }
+
+void *array_list_create_with(size_t type_size, size_t init_cap, const sncl_allocator_t *allocator) {
+    return create(type_size, init_cap, 0, allocator);
+}
+
+void *array_list_create_aligned(size_t type_size, size_t init_cap, size_t alignment) {
+    assert((alignment & (alignment - 1)) == 0 && "arraylist alignment must be a power of two");
+    return create(type_size, init_cap, alignment, NULL);
+}
+
+void *array_list_create_inline(size_t type_size, void *buffer, size_t buffer_size) {
+    assert(buffer_size >= sizeof(array_list_t) && "inline arraylist buffer is too small to hold the header");
+    assert((uintptr_t)buffer % sizeof(size_t) == 0 && "inline arraylist buffer is misaligned");
+
+    array_list_t *list = (array_list_t *)buffer;
+    list->allocator = &inline_storage;
+    list->growth = ARRAY_LIST_GROW_DOUBLE;
+    list->growth_param = 0;
+    list->reallocations = 0;
+    list->bytes_copied = 0;
+    list->alignment = 0;
+    list->padding = 0;
     list->type_size = type_size;
-    list->capacity = init_cap;
+    list->capacity = type_size ? (buffer_size - sizeof(array_list_t)) / type_size : 0;
     list->size = 0;
     return (void *)list->data;
 }
 
+bool array_list_is_inline(void *list) {
+    array_list_t *arr = retrieve_from_data(list);
+    return arr->allocator == &inline_storage;
+}
+
 void array_list_destroy(void *list) {
     array_list_t *arr = retrieve_from_data(list);
-    free(arr);
+    if (is_view(arr))
+        return;
+    list_free(arr->allocator, block_of(arr), block_size(arr->alignment, arr->type_size, arr->capacity));
+}
+
+const sncl_allocator_t *array_list_allocator(void *list) {
+    array_list_t *arr = retrieve_from_data(list);
+    return is_view(arr) || is_mapped(arr) ? NULL : arr->allocator;
+}
+
+size_t array_list_alignment(void *list) {
+    array_list_t *arr = retrieve_from_data(list);
+    return arr->alignment;
 }
 
 void *array_list_vbegin(void *list) { return list; }
@@ -45,21 +163,50 @@ size_t array_list_size(void *list) {
     return arr->size;
 }
 
+size_t array_list_type_size(void *list) {
+    array_list_t *arr = retrieve_from_data(list);
+    return arr->type_size;
+}
+
 size_t array_list_capacity(void *list) {
     array_list_t *arr = retrieve_from_data(list);
     return arr->capacity;
 }
 
 void array_list_vpush_back(void **list, void *value) {
+    // goes through the bulk path so that pushing an element of the list itself survives a reallocation
+    array_list_vpush_back_n(list, value, 1);
+}
+
+void array_list_vpush_back_n(void **list, const void *values, size_t n) {
+    array_list_t *arr = retrieve_from_data(*list);
+    const uint8_t *src = (const uint8_t *)values;
+
+    // values may come from the list itself, which growing would move out from under us
+    bool aliased = src >= arr->data && src < arr->data + arr->capacity * arr->type_size;
+    size_t src_offset = aliased ? (size_t)(src - arr->data) : 0;
+
+    uint8_t *slots = (uint8_t *)array_list_vemplace_back_n(list, n);
+    if (!slots)
+        return;
+    if (aliased)
+        src = (const uint8_t *)*list + src_offset;
+
+    memcpy(slots, src, n * retrieve_from_data(*list)->type_size);
+}
+
+void *array_list_vemplace_back_n(void **list, size_t n) {
     array_list_t *arr = retrieve_from_data(*list);
 
-    if (arr->size >= arr->capacity) {
-        array_list_vreserve(list, arr->capacity * 2);
+    if (arr->size + n > arr->capacity) {
+        if (!resize(list, grow_capacity(arr, arr->size + n)))
+            return NULL;
         arr = retrieve_from_data(*list);
     }
 
-    memcpy(arr->data + arr->type_size * arr->size, value, arr->type_size);
-    arr->size++;
+    uint8_t *slots = arr->data + arr->type_size * arr->size;
+    arr->size += n;
+    return (void *)slots;
 }
 
 void array_list_vinsert(void **list, void *at, void *begin, void *end) {
@@ -72,11 +219,9 @@ void array_list_vinsert(void **list, void *at, void *begin, void *end) {
     size_t offset = ((uint8_t *)at - (uint8_t *)array_list_vbegin(*list)) / arr->type_size;
 
     size_t needed = arr->size + added;
-    if (arr->capacity <= needed) {
-        size_t expected = arr->capacity;
-        while (expected < needed)
-            expected *= 2;
-        array_list_vreserve(list, expected);
+    if (arr->capacity < needed) {
+        if (!resize(list, grow_capacity(arr, needed)))
+            return;
         arr = retrieve_from_data(*list);
     }
 
@@ -94,13 +239,233 @@ void array_list_clear(void *list) {
 
 void array_list_vreserve(void **list, size_t cap) {
     array_list_t *arr = retrieve_from_data(*list);
-    if (cap < arr->capacity)
+    if (cap <= arr->capacity)
         return;
 
-    array_list_t *new_arr = realloc(arr, sizeof(array_list_t) + arr->type_size * cap);
-    assert(new_arr != NULL && "failed to allocate new array when reserving capacity");
-    new_arr->capacity = cap;
-    *list = new_arr->data;
+    resize(list, cap);
+}
+
+void array_list_vshrink_to_fit(void **list) {
+    array_list_t *arr = retrieve_from_data(*list);
+    // the caller's buffer can't shrink, and moving to the heap would be the opposite of giving memory back
+    if (arr->size == arr->capacity || arr->allocator == &inline_storage)
+        return;
+
+    resize(list, arr->size);
+}
+
+void array_list_set_growth(void *list, array_list_growth_t growth, size_t param) {
+    array_list_t *arr = retrieve_from_data(list);
+    arr->growth = growth;
+    arr->growth_param = param;
+}
+
+array_list_growth_t array_list_growth(void *list) {
+    array_list_t *arr = retrieve_from_data(list);
+    return arr->growth;
+}
+
+size_t array_list_reallocations(void *list) {
+    array_list_t *arr = retrieve_from_data(list);
+    return arr->reallocations;
+}
+
+size_t array_list_bytes_copied(void *list) {
+    array_list_t *arr = retrieve_from_data(list);
+    return arr->bytes_copied;
+}
+
+void *array_list_open_mapped(const char *path, size_t type_size, array_list_map_mode_t mode) {
+#ifdef ARRAY_LIST_MAPPED
+    bool read_only = mode == ARRAY_LIST_MAP_READ_ONLY;
+    int fd = open(path, read_only ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t length = (size_t)st.st_size;
+    bool fresh = length == 0 && !read_only;
+    if (fresh) {
+        length = block_size(0, type_size, 16);
+        if (ftruncate(fd, (off_t)length) != 0) {
+            close(fd);
+            return NULL;
+        }
+    }
+
+    if (length < sizeof(array_list_t)) {
+        close(fd);
+        return NULL;
+    }
+
+    // read-only lists are mapped privately so patching the header below only copies its page, the elements stay
+    // shared with the page cache (and every other process mapping the same file)
+    uint8_t *block = mapped_map(fd, length, read_only ? MAP_PRIVATE : MAP_SHARED, NULL, 0);
+    if (!block) {
+        close(fd);
+        return NULL;
+    }
+
+    array_list_t *arr = (array_list_t *)block;
+    if (fresh) {
+        arr->growth = ARRAY_LIST_GROW_DOUBLE;
+        arr->growth_param = 0;
+        arr->reallocations = 0;
+        arr->bytes_copied = 0;
+        arr->alignment = 0;
+        arr->padding = 0;
+        arr->type_size = type_size;
+        arr->capacity = 16;
+        arr->size = 0;
+    } else if (arr->type_size != type_size || arr->alignment != 0 || arr->padding != 0 || arr->size > arr->capacity ||
+               block_size(0, arr->type_size, arr->capacity) != length) {
+        munmap(block - mapped_guard_size(), mapped_guard_size() + length);
+        close(fd);
+        return NULL;
+    }
+
+    mapped_ctx_t *ctx = (mapped_ctx_t *)malloc(sizeof(mapped_ctx_t));
+    assert(ctx != NULL && "failed to allocate mapping state when opening a mapped array list");
+    ctx->fd = fd;
+    ctx->read_only = read_only;
+    ctx->length_stale = false;
+    mapped_ctx_of(block) = ctx;
+
+    // the allocator tag is always set on load, whatever the file holds in that field
+    arr->allocator = MAPPED_ALLOCATOR;
+    return (void *)arr->data;
+#else
+    (void)path;
+    (void)type_size;
+    (void)mode;
+    return NULL;
+#endif
+}
+
+bool array_list_is_mapped(void *list) {
+#ifdef ARRAY_LIST_MAPPED
+    return is_mapped(retrieve_from_data(list));
+#else
+    (void)list;
+    return false;
+#endif
+}
+
+bool array_list_flush(void *list) {
+#ifdef ARRAY_LIST_MAPPED
+    if (!array_list_is_mapped(list))
+        return false;
+
+    array_list_t *arr = retrieve_from_data(list);
+    mapped_ctx_t *ctx = mapped_ctx_of(block_of(arr));
+    size_t length = block_size(arr->alignment, arr->type_size, arr->capacity);
+    if (ctx->read_only)
+        return false;
+    if (ctx->length_stale) {
+        if (ftruncate(ctx->fd, (off_t)length) != 0)
+            return false;
+        ctx->length_stale = false;
+    }
+    return msync(block_of(arr), length, MS_SYNC) == 0;
+#else
+    (void)list;
+    return false;
+#endif
+}
+
+bool array_list_write(int fd, void *list) {
+#ifdef ARRAY_LIST_MAPPED
+    array_list_t *arr = retrieve_from_data(list);
+    size_t alignment = arr->alignment > DISK_ALIGNMENT ? arr->alignment : DISK_ALIGNMENT;
+    size_t data_offset = (sizeof(disk_header_t) + sizeof(array_list_t) + alignment - 1) / alignment * alignment;
+
+    // everything up to the elements is built in one buffer, so the whole file takes two writes
+    uint8_t *prefix = (uint8_t *)calloc(1, data_offset);
+    if (!prefix)
+        return false;
+
+    disk_header_t *disk = (disk_header_t *)prefix;
+    memcpy(disk->magic, DISK_MAGIC, sizeof(disk->magic));
+    disk->version = DISK_VERSION;
+    disk->endian = DISK_ENDIAN;
+    disk->word_size = (uint32_t)sizeof(size_t);
+    disk->header_size = (uint32_t)sizeof(array_list_t);
+    disk->alignment = alignment;
+    disk->data_offset = data_offset;
+    disk->type_size = arr->type_size;
+    disk->size = arr->size;
+
+    array_list_t image;
+    memset(&image, 0, sizeof(image));
+    image.allocator = VIEW_ALLOCATOR;
+    image.growth = ARRAY_LIST_GROW_DOUBLE;
+    image.alignment = alignment;
+    image.type_size = arr->type_size;
+    image.capacity = arr->size;
+    image.size = arr->size;
+    memcpy(prefix + data_offset - sizeof(array_list_t), &image, sizeof(image));
+
+    const uint8_t *chunks[2] = { prefix, arr->data };
+    size_t lengths[2] = { data_offset, arr->size * arr->type_size };
+    bool ok = true;
+    for (int c = 0; c < 2 && ok; c++) {
+        size_t done = 0;
+        while (done < lengths[c]) {
+            ssize_t n = write(fd, chunks[c] + done, lengths[c] - done);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n < 0) {
+                ok = false;
+                break;
+            }
+            done += (size_t)n;
+        }
+    }
+
+    free(prefix);
+    return ok;
+#else
+    (void)fd;
+    (void)list;
+    return false;
+#endif
+}
+
+void *array_list_read_view(const void *buffer, size_t length) {
+    const uint8_t *bytes = (const uint8_t *)buffer;
+    if (length < sizeof(disk_header_t) || (uintptr_t)bytes % sizeof(uint64_t) != 0)
+        return NULL;
+
+    const disk_header_t *disk = (const disk_header_t *)bytes;
+    if (memcmp(disk->magic, DISK_MAGIC, sizeof(disk->magic)) != 0 || disk->version != DISK_VERSION ||
+        disk->endian != DISK_ENDIAN || disk->word_size != sizeof(size_t) || disk->header_size != sizeof(array_list_t))
+        return NULL;
+
+    if (disk->alignment == 0 || (disk->alignment & (disk->alignment - 1)) != 0 ||
+        disk->data_offset % disk->alignment != 0 || disk->data_offset < sizeof(disk_header_t) + sizeof(array_list_t) ||
+        disk->data_offset > length || (disk->type_size && disk->size > (length - disk->data_offset) / disk->type_size))
+        return NULL;
+
+    // the elements only keep their alignment if the buffer is aligned at least as strictly as the writer's was
+    if ((uintptr_t)bytes % disk->alignment != 0)
+        return NULL;
+
+    const array_list_t *image = (const array_list_t *)(bytes + disk->data_offset - sizeof(array_list_t));
+    if (!is_view(image) || image->type_size != disk->type_size || image->size != disk->size ||
+        image->capacity != disk->size)
+        return NULL;
+
+    return (void *)image->data;
+}
+
+bool array_list_is_view(void *list) {
+    array_list_t *arr = retrieve_from_data(list);
+    return is_view(arr);
 }
 
 void array_list_erase(void *list, void *begin, void *end) {
@@ -114,3 +479,274 @@ void array_list_erase(void *list, void *begin, void *end) {
             (arr->size - offset) * arr->type_size);
     arr->size -= removing;
 }
+
+size_t array_list_erase_if(void *list, bool (*pred)(const void *elem, void *ctx), void *ctx) {
+    array_list_t *arr = retrieve_from_data(list);
+    size_t ts = arr->type_size;
+
+    // kept elements are moved down a whole run at a time, so a sweep that removes little copies little
+    size_t write = 0, run_start = 0;
+    for (size_t read = 0; read < arr->size; read++) {
+        if (!pred(arr->data + read * ts, ctx))
+            continue;
+
+        if (read > run_start) {
+            if (write != run_start)
+                memmove(arr->data + write * ts, arr->data + run_start * ts, (read - run_start) * ts);
+            write += read - run_start;
+        }
+        run_start = read + 1;
+    }
+
+    if (arr->size > run_start) {
+        if (write != run_start)
+            memmove(arr->data + write * ts, arr->data + run_start * ts, (arr->size - run_start) * ts);
+        write += arr->size - run_start;
+    }
+
+    size_t removed = arr->size - write;
+    arr->size = write;
+    return removed;
+}
+
+void array_list_swap_remove(void *list, size_t idx) {
+    array_list_t *arr = retrieve_from_data(list);
+    assert(idx < arr->size && "arraylist swap_remove index out of range");
+
+    arr->size--;
+    if (idx != arr->size)
+        memcpy(arr->data + idx * arr->type_size, arr->data + arr->size * arr->type_size, arr->type_size);
+}
+
+void array_list_erase_indices(void *list, const size_t *indices, size_t count) {
+    array_list_t *arr = retrieve_from_data(list);
+    size_t ts = arr->type_size;
+    if (count == 0)
+        return;
+
+    // every run between two removed indices moves down once, by however many indices came before it
+    size_t write = indices[0];
+    for (size_t i = 0; i < count; i++) {
+        assert(indices[i] < arr->size && "arraylist erase index out of range");
+        assert((i == 0 || indices[i - 1] < indices[i]) && "arraylist erase indices must be sorted and unique");
+
+        size_t run_start = indices[i] + 1;
+        size_t run_end = i + 1 < count ? indices[i + 1] : arr->size;
+        memmove(arr->data + write * ts, arr->data + run_start * ts, (run_end - run_start) * ts);
+        write += run_end - run_start;
+    }
+
+    arr->size = write;
+}
+
+// Picks the next capacity that fits `needed` elements according to the list's growth policy.
+static size_t grow_capacity(array_list_t *arr, size_t needed) {
+    size_t cap = arr->capacity;
+
+    switch (arr->growth) {
+    case ARRAY_LIST_GROW_HALF:
+        while (cap < needed)
+            cap += cap / 2 + 1;
+        break;
+    case ARRAY_LIST_GROW_FIXED: {
+        size_t step = arr->growth_param ? arr->growth_param : 1;
+        cap += (needed - cap + step - 1) / step * step;
+        break;
+    }
+    case ARRAY_LIST_GROW_PAGED:
+        if (block_size(arr->alignment, arr->type_size, cap) < arr->growth_param) {
+            while (cap < needed)
+                cap = cap ? cap * 2 : 1;
+            break;
+        }
+
+        // past the threshold, grow by half and round the whole block up to a page boundary
+        if (cap + cap / 2 > needed)
+            needed = cap + cap / 2;
+        size_t bytes = block_size(arr->alignment, arr->type_size, needed);
+        bytes = (bytes + ARRAY_LIST_PAGE_SIZE - 1) / ARRAY_LIST_PAGE_SIZE * ARRAY_LIST_PAGE_SIZE;
+        cap = arr->type_size ? (bytes - block_size(arr->alignment, 0, 0)) / arr->type_size : needed;
+        break;
+    case ARRAY_LIST_GROW_DOUBLE:
+    default:
+        while (cap < needed)
+            cap = cap ? cap * 2 : 1;
+        break;
+    }
+
+    return cap;
+}
+
+static void *create(size_t type_size, size_t init_cap, size_t alignment, const sncl_allocator_t *allocator) {
+    uint8_t *block = (uint8_t *)list_alloc(allocator, block_size(alignment, type_size, init_cap));
+    assert(block != NULL && "failed to allocate array list when instantiating");
+
+    size_t padding = data_padding(block, alignment);
+    array_list_t *list = (array_list_t *)(block + padding);
+    list->allocator = allocator;
+    list->growth = ARRAY_LIST_GROW_DOUBLE;
+    list->growth_param = 0;
+    list->reallocations = 0;
+    list->bytes_copied = 0;
+    list->alignment = alignment;
+    list->padding = padding;
+    list->type_size = type_size;
+    list->capacity = init_cap;
+    list->size = 0;
+    return (void *)list->data;
+}
+
+// Returns how far into `block` the header has to start for `data` to land on an `alignment` boundary.
+static size_t data_padding(uint8_t *block, size_t alignment) {
+    if (alignment <= 1)
+        return 0;
+    uintptr_t data = (uintptr_t)(block + sizeof(array_list_t));
+    return (alignment - (data & (alignment - 1))) & (alignment - 1);
+}
+
+// Reallocates the list to exactly `cap` elements, keeping track of how much the move cost. Returns `false`, leaving the
+// list as it was, if the allocator can't provide the memory (a read-only mapped list never can).
+static bool resize(void **list, size_t cap) {
+    array_list_t *arr = retrieve_from_data(*list);
+    size_t alignment = arr->alignment;
+    size_t old_padding = arr->padding;
+    size_t used = arr->size * arr->type_size;
+    uint8_t *block = block_of(arr);
+    uintptr_t old_address = (uintptr_t)block; // `block` is indeterminate once the realloc has moved it
+    assert(!is_view(arr) && "arraylist views are read-only and can't be resized");
+
+    uint8_t *new_block = (uint8_t *)list_realloc(arr->allocator, block,
+                                                 block_size(alignment, arr->type_size, arr->capacity),
+                                                 block_size(alignment, arr->type_size, cap));
+    assert((new_block != NULL || is_mapped(arr)) && "failed to allocate new array when reserving capacity");
+    if (!new_block)
+        return false;
+
+    // the allocator only promises its own alignment, so the header and data may have to shift to stay aligned
+    size_t padding = data_padding(new_block, alignment);
+    array_list_t *new_arr = (array_list_t *)(new_block + padding);
+    if (padding != old_padding) {
+        memmove(new_arr, new_block + old_padding, sizeof(array_list_t) + used);
+        new_arr->padding = padding;
+        new_arr->bytes_copied += used;
+    }
+
+    new_arr->capacity = cap;
+    new_arr->reallocations++;
+    if ((uintptr_t)new_block != old_address)
+        new_arr->bytes_copied += used;
+    if (new_arr->allocator == &inline_storage)
+        new_arr->allocator = NULL; // spilled out of the caller's buffer and onto the heap
+    *list = new_arr->data;
+    return true;
+}
+
+static void *inline_realloc(__attribute__((unused)) void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    void *spilled = malloc(new_size);
+    if (!spilled)
+        return NULL;
+    memcpy(spilled, ptr, old_size < new_size ? old_size : new_size);
+    return spilled;
+}
+
+static void inline_free(__attribute__((unused)) void *ctx, __attribute__((unused)) void *ptr,
+                        __attribute__((unused)) size_t size) {}
+
+#ifdef ARRAY_LIST_MAPPED
+// the private page in front of a mapping only has to fit the state pointer, but `MAP_FIXED` wants whole pages
+static size_t mapped_guard_size(void) {
+    long page = sysconf(_SC_PAGESIZE);
+    return page > 0 ? (size_t)page : ARRAY_LIST_PAGE_SIZE;
+}
+
+// Maps `length` bytes of `fd` behind a fresh private page and returns the start of the file's bytes, or `NULL`.
+// If `old` is given the old mapping (of `old_length` bytes) is moved there, it is only released once the new mapping
+// is in place, so a failure leaves it untouched.
+static uint8_t *mapped_map(int fd, size_t length, int flags, void *old, size_t old_length) {
+    size_t guard = mapped_guard_size();
+    uint8_t *base = (uint8_t *)mmap(NULL, guard + length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (base == MAP_FAILED)
+        return NULL;
+
+#ifdef __linux__
+    void *block = old ? mremap(old, old_length, length, MREMAP_MAYMOVE | MREMAP_FIXED, base + guard)
+                      : mmap(base + guard, length, PROT_READ | PROT_WRITE, flags | MAP_FIXED, fd, 0);
+#else
+    void *block = mmap(base + guard, length, PROT_READ | PROT_WRITE, flags | MAP_FIXED, fd, 0);
+#endif
+    if (block == MAP_FAILED) {
+        munmap(base, guard + length);
+        return NULL;
+    }
+
+    if (old) {
+        mapped_ctx_of(block) = mapped_ctx_of(old);
+#ifndef __linux__
+        munmap(old, old_length);
+#endif
+        munmap((uint8_t *)old - guard, guard);
+    }
+    return (uint8_t *)block;
+}
+
+// Resizes the backing file and the mapping together. Growing extends the file first and shrinking truncates last, so
+// the mapping never reaches past the end of the file.
+static void *mapped_realloc(mapped_ctx_t *m, void *ptr, size_t old_size, size_t new_size) {
+    if (m->read_only)
+        return NULL;
+
+    if (new_size > old_size && ftruncate(m->fd, (off_t)new_size) != 0)
+        return NULL;
+
+    uint8_t *moved = mapped_map(m->fd, new_size, MAP_SHARED, ptr, old_size);
+    if (!moved) {
+        // the old mapping is untouched, only the file has to go back to its length
+        if (new_size > old_size && ftruncate(m->fd, (off_t)old_size) != 0)
+            m->length_stale = true;
+        return NULL;
+    }
+
+    // the list already lives at `moved`, a file left too long only wastes space until the next flush
+    if (new_size < old_size && ftruncate(m->fd, (off_t)new_size) != 0)
+        m->length_stale = true;
+    else
+        m->length_stale = false;
+    return moved;
+}
+
+static void mapped_free(mapped_ctx_t *m, void *ptr, size_t size) {
+    size_t guard = mapped_guard_size();
+    // there's no caller left to tell if this fails, `array_list_flush` before destroying is how a failure gets reported
+    if (m->length_stale)
+        (void)ftruncate(m->fd, (off_t)size);
+    munmap((uint8_t *)ptr - guard, guard + size);
+    close(m->fd);
+    free(m);
+}
+#endif
+
+static void *list_alloc(const sncl_allocator_t *allocator, size_t size) {
+    if (!allocator)
+        return malloc(size);
+    return allocator->alloc(allocator->ctx, size);
+}
+
+static void *list_realloc(const sncl_allocator_t *allocator, void *ptr, size_t old_size, size_t new_size) {
+    if (!allocator)
+        return realloc(ptr, new_size);
+#ifdef ARRAY_LIST_MAPPED
+    if (allocator == MAPPED_ALLOCATOR)
+        return mapped_realloc(mapped_ctx_of(ptr), ptr, old_size, new_size);
+#endif
+    return allocator->realloc(allocator->ctx, ptr, old_size, new_size);
+}
+
+static void list_free(const sncl_allocator_t *allocator, void *ptr, size_t size) {
+    if (!allocator)
+        return free(ptr);
+#ifdef ARRAY_LIST_MAPPED
+    if (allocator == MAPPED_ALLOCATOR)
+        return mapped_free(mapped_ctx_of(ptr), ptr, size);
+#endif
+    allocator->free(allocator->ctx, ptr, size);
+}
@@ -0,0 +1,915 @@
+// sysconf and pthreads are POSIX, which a strict C99 build hides otherwise
+#if !defined(_POSIX_C_SOURCE) && defined(__unix__)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <sncl_arraylist_algo.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <unistd.h>
+#define SORT_THREADS
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ALGO_X86
+#define AVX2 __attribute__((target("avx2")))
+#endif
+
+static bool have_avx2(void);
+
+//// scalar kernels, used for the tails of the vector loops and on CPUs without SSE2/AVX2
+
+static size_t find_scalar(const uint8_t *data, size_t n, size_t type_size, const void *value) {
+#define FIND_TYPED(T)                                                                                                  \
+    do {                                                                                                               \
+        T v;                                                                                                           \
+        memcpy(&v, value, sizeof(T));                                                                                  \
+        const T *p = (const T *)data;                                                                                  \
+        for (size_t i = 0; i < n; i++)                                                                                 \
+            if (p[i] == v)                                                                                             \
+                return i;                                                                                              \
+        return n;                                                                                                      \
+    } while (0)
+
+    switch (type_size) {
+    case 1:
+        FIND_TYPED(uint8_t);
+    case 2:
+        FIND_TYPED(uint16_t);
+    case 4:
+        FIND_TYPED(uint32_t);
+    case 8:
+        FIND_TYPED(uint64_t);
+    default:
+        for (size_t i = 0; i < n; i++)
+            if (memcmp(data + i * type_size, value, type_size) == 0)
+                return i;
+        return n;
+    }
+#undef FIND_TYPED
+}
+
+static size_t count_scalar(const uint8_t *data, size_t n, size_t type_size, const void *value) {
+    size_t count = 0;
+
+#define COUNT_TYPED(T)                                                                                                 \
+    do {                                                                                                               \
+        T v;                                                                                                           \
+        memcpy(&v, value, sizeof(T));                                                                                  \
+        const T *p = (const T *)data;                                                                                  \
+        for (size_t i = 0; i < n; i++)                                                                                 \
+            count += p[i] == v;                                                                                        \
+        return count;                                                                                                  \
+    } while (0)
+
+    switch (type_size) {
+    case 1:
+        COUNT_TYPED(uint8_t);
+    case 2:
+        COUNT_TYPED(uint16_t);
+    case 4:
+        COUNT_TYPED(uint32_t);
+    case 8:
+        COUNT_TYPED(uint64_t);
+    default:
+        for (size_t i = 0; i < n; i++)
+            count += memcmp(data + i * type_size, value, type_size) == 0;
+        return count;
+    }
+#undef COUNT_TYPED
+}
+
+#define DEFINE_SUM_SCALAR(name, T, ACC)                                                                                \
+    static ACC sum_scalar_##name(const T *p, size_t n) {                                                               \
+        ACC acc = 0;                                                                                                   \
+        for (size_t i = 0; i < n; i++)                                                                                 \
+            acc += (ACC)p[i];                                                                                          \
+        return acc;                                                                                                    \
+    }
+
+DEFINE_SUM_SCALAR(i8, int8_t, int64_t)
+DEFINE_SUM_SCALAR(u8, uint8_t, uint64_t)
+DEFINE_SUM_SCALAR(i16, int16_t, int64_t)
+DEFINE_SUM_SCALAR(u16, uint16_t, uint64_t)
+DEFINE_SUM_SCALAR(i32, int32_t, int64_t)
+DEFINE_SUM_SCALAR(u32, uint32_t, uint64_t)
+DEFINE_SUM_SCALAR(i64, int64_t, int64_t)
+DEFINE_SUM_SCALAR(u64, uint64_t, uint64_t)
+DEFINE_SUM_SCALAR(f32, float, double)
+DEFINE_SUM_SCALAR(f64, double, double)
+
+#define DEFINE_MINMAX_SCALAR(name, T)                                                                                  \
+    static void minmax_scalar_##name(const T *p, size_t n, T *min, T *max) {                                           \
+        T lo = *min, hi = *max;                                                                                        \
+        for (size_t i = 0; i < n; i++) {                                                                               \
+            lo = p[i] < lo ? p[i] : lo;                                                                                \
+            hi = p[i] > hi ? p[i] : hi;                                                                                \
+        }                                                                                                              \
+        *min = lo;                                                                                                     \
+        *max = hi;                                                                                                     \
+    }
+
+DEFINE_MINMAX_SCALAR(i8, int8_t)
+DEFINE_MINMAX_SCALAR(u8, uint8_t)
+DEFINE_MINMAX_SCALAR(i16, int16_t)
+DEFINE_MINMAX_SCALAR(u16, uint16_t)
+DEFINE_MINMAX_SCALAR(i32, int32_t)
+DEFINE_MINMAX_SCALAR(u32, uint32_t)
+DEFINE_MINMAX_SCALAR(i64, int64_t)
+DEFINE_MINMAX_SCALAR(u64, uint64_t)
+DEFINE_MINMAX_SCALAR(f32, float)
+DEFINE_MINMAX_SCALAR(f64, double)
+
+#ifdef ALGO_X86
+
+//// equality kernels
+// The byte mask from a compare has every bit of a matching lane set. `fold` keeps a single bit per matching lane so the
+// lowest set bit gives the first match and the popcount gives the number of matches.
+
+#define FOLD_1(m) (m)
+#define FOLD_2(m) ((m) & 0x55555555u)
+#define FOLD_4(m) ((m) & 0x11111111u)
+#define FOLD_8(m) ((m) & 0x01010101u)
+// SSE2 has no 64-bit compare, both 32-bit halves have to match instead
+#define FOLD_8_SSE2(m) ((m) & ((m) >> 4) & 0x0101u)
+
+#ifdef __SSE2__
+#define DEFINE_EQ_SSE2(bytes, T, set1, cmpeq, fold)                                                                    \
+    static size_t find_sse2_##bytes(const uint8_t *data, size_t n, const void *value) {                                \
+        T v;                                                                                                           \
+        memcpy(&v, value, sizeof(T));                                                                                  \
+        __m128i needle = set1(v);                                                                                      \
+        size_t total = n * bytes, i = 0;                                                                               \
+        for (; i + 16 <= total; i += 16) {                                                                             \
+            __m128i chunk = _mm_loadu_si128((const __m128i *)(data + i));                                              \
+            uint32_t hits = fold((uint32_t)_mm_movemask_epi8(cmpeq(chunk, needle)));                                   \
+            if (hits)                                                                                                  \
+                return (i + (size_t)__builtin_ctz(hits)) / bytes;                                                      \
+        }                                                                                                              \
+        return i / bytes + find_scalar(data + i, n - i / bytes, bytes, value);                                         \
+    }                                                                                                                  \
+    static size_t count_sse2_##bytes(const uint8_t *data, size_t n, const void *value) {                               \
+        T v;                                                                                                           \
+        memcpy(&v, value, sizeof(T));                                                                                  \
+        __m128i needle = set1(v);                                                                                      \
+        size_t total = n * bytes, i = 0, count = 0;                                                                    \
+        for (; i + 16 <= total; i += 16) {                                                                             \
+            __m128i chunk = _mm_loadu_si128((const __m128i *)(data + i));                                              \
+            count += (size_t)__builtin_popcount(fold((uint32_t)_mm_movemask_epi8(cmpeq(chunk, needle))));              \
+        }                                                                                                              \
+        return count + count_scalar(data + i, n - i / bytes, bytes, value);                                            \
+    }
+
+DEFINE_EQ_SSE2(1, int8_t, _mm_set1_epi8, _mm_cmpeq_epi8, FOLD_1)
+DEFINE_EQ_SSE2(2, int16_t, _mm_set1_epi16, _mm_cmpeq_epi16, FOLD_2)
+DEFINE_EQ_SSE2(4, int32_t, _mm_set1_epi32, _mm_cmpeq_epi32, FOLD_4)
+DEFINE_EQ_SSE2(8, int64_t, _mm_set1_epi64x, _mm_cmpeq_epi32, FOLD_8_SSE2)
+#endif // __SSE2__
+
+#define DEFINE_EQ_AVX2(bytes, T, set1, cmpeq, fold)                                                                    \
+    static AVX2 size_t find_avx2_##bytes(const uint8_t *data, size_t n, const void *value) {                           \
+        T v;                                                                                                           \
+        memcpy(&v, value, sizeof(T));                                                                                  \
+        __m256i needle = set1(v);                                                                                      \
+        size_t total = n * bytes, i = 0;                                                                               \
+        for (; i + 32 <= total; i += 32) {                                                                             \
+            __m256i chunk = _mm256_loadu_si256((const __m256i *)(data + i));                                           \
+            uint32_t hits = fold((uint32_t)_mm256_movemask_epi8(cmpeq(chunk, needle)));                                \
+            if (hits)                                                                                                  \
+                return (i + (size_t)__builtin_ctz(hits)) / bytes;                                                      \
+        }                                                                                                              \
+        return i / bytes + find_scalar(data + i, n - i / bytes, bytes, value);                                         \
+    }                                                                                                                  \
+    static AVX2 size_t count_avx2_##bytes(const uint8_t *data, size_t n, const void *value) {                          \
+        T v;                                                                                                           \
+        memcpy(&v, value, sizeof(T));                                                                                  \
+        __m256i needle = set1(v);                                                                                      \
+        size_t total = n * bytes, i = 0, count = 0;                                                                    \
+        for (; i + 32 <= total; i += 32) {                                                                             \
+            __m256i chunk = _mm256_loadu_si256((const __m256i *)(data + i));                                           \
+            count += (size_t)__builtin_popcount(fold((uint32_t)_mm256_movemask_epi8(cmpeq(chunk, needle))));           \
+        }                                                                                                              \
+        return count + count_scalar(data + i, n - i / bytes, bytes, value);                                            \
+    }
+
+DEFINE_EQ_AVX2(1, int8_t, _mm256_set1_epi8, _mm256_cmpeq_epi8, FOLD_1)
+DEFINE_EQ_AVX2(2, int16_t, _mm256_set1_epi16, _mm256_cmpeq_epi16, FOLD_2)
+DEFINE_EQ_AVX2(4, int32_t, _mm256_set1_epi32, _mm256_cmpeq_epi32, FOLD_4)
+DEFINE_EQ_AVX2(8, int64_t, _mm256_set1_epi64x, _mm256_cmpeq_epi64, FOLD_8)
+
+//// reduction kernels
+
+static AVX2 int64_t hsum_epi64(__m256i v) {
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+static AVX2 double hsum_pd(__m256d v) {
+    double lanes[4];
+    _mm256_storeu_pd(lanes, v);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+// 32-bit lanes are widened to 64 bits before adding so long lists don't overflow the accumulator
+#define DEFINE_SUM32_AVX2(name, T, widen)                                                                              \
+    static AVX2 int64_t sum_avx2_##name(const T *p, size_t n) {                                                        \
+        __m256i acc = _mm256_setzero_si256();                                                                          \
+        size_t i = 0;                                                                                                  \
+        for (; i + 8 <= n; i += 8) {                                                                                   \
+            __m256i x = _mm256_loadu_si256((const __m256i *)(p + i));                                                  \
+            acc = _mm256_add_epi64(acc, widen(_mm256_castsi256_si128(x)));                                             \
+            acc = _mm256_add_epi64(acc, widen(_mm256_extracti128_si256(x, 1)));                                        \
+        }                                                                                                              \
+        return hsum_epi64(acc) + (int64_t)sum_scalar_##name(p + i, n - i);                                             \
+    }
+
+DEFINE_SUM32_AVX2(i32, int32_t, _mm256_cvtepi32_epi64)
+DEFINE_SUM32_AVX2(u32, uint32_t, _mm256_cvtepu32_epi64)
+
+static AVX2 int64_t sum_avx2_64(const int64_t *p, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm256_add_epi64(acc, _mm256_loadu_si256((const __m256i *)(p + i)));
+    return hsum_epi64(acc) + sum_scalar_i64(p + i, n - i);
+}
+
+static AVX2 double sum_avx2_f32(const float *p, size_t n) {
+    __m256d lo = _mm256_setzero_pd(), hi = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        lo = _mm256_add_pd(lo, _mm256_cvtps_pd(_mm_loadu_ps(p + i)));
+        hi = _mm256_add_pd(hi, _mm256_cvtps_pd(_mm_loadu_ps(p + i + 4)));
+    }
+    return hsum_pd(_mm256_add_pd(lo, hi)) + sum_scalar_f32(p + i, n - i);
+}
+
+static AVX2 double sum_avx2_f64(const double *p, size_t n) {
+    __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a = _mm256_add_pd(a, _mm256_loadu_pd(p + i));
+        b = _mm256_add_pd(b, _mm256_loadu_pd(p + i + 4));
+    }
+    return hsum_pd(_mm256_add_pd(a, b)) + sum_scalar_f64(p + i, n - i);
+}
+
+// `min` and `max` come in seeded with the first element, like the scalar kernels
+#define DEFINE_MINMAX_AVX2(name, T, V, load, store, set1, minop, maxop)                                                \
+    static AVX2 void minmax_avx2_##name(const T *p, size_t n, T *min, T *max) {                                        \
+        const size_t lanes = sizeof(V) / sizeof(T);                                                                    \
+        V lo = set1(*min), hi = set1(*max);                                                                            \
+        size_t i = 0;                                                                                                  \
+        for (; i + lanes <= n; i += lanes) {                                                                           \
+            V x = load((const void *)(p + i));                                                                         \
+            lo = minop(lo, x);                                                                                         \
+            hi = maxop(hi, x);                                                                                         \
+        }                                                                                                              \
+        T tmp[sizeof(V) / sizeof(T)];                                                                                  \
+        store((void *)tmp, lo);                                                                                        \
+        minmax_scalar_##name(tmp, lanes, min, max);                                                                    \
+        store((void *)tmp, hi);                                                                                        \
+        minmax_scalar_##name(tmp, lanes, min, max);                                                                    \
+        minmax_scalar_##name(p + i, n - i, min, max);                                                                  \
+    }
+
+#define LOAD_SI256(p) _mm256_loadu_si256((const __m256i *)(p))
+#define STORE_SI256(p, v) _mm256_storeu_si256((__m256i *)(p), v)
+#define LOAD_PS(p) _mm256_loadu_ps((const float *)(p))
+#define STORE_PS(p, v) _mm256_storeu_ps((float *)(p), v)
+#define LOAD_PD(p) _mm256_loadu_pd((const double *)(p))
+#define STORE_PD(p, v) _mm256_storeu_pd((double *)(p), v)
+
+DEFINE_MINMAX_AVX2(i8, int8_t, __m256i, LOAD_SI256, STORE_SI256, _mm256_set1_epi8, _mm256_min_epi8, _mm256_max_epi8)
+DEFINE_MINMAX_AVX2(u8, uint8_t, __m256i, LOAD_SI256, STORE_SI256, _mm256_set1_epi8, _mm256_min_epu8, _mm256_max_epu8)
+DEFINE_MINMAX_AVX2(i16, int16_t, __m256i, LOAD_SI256, STORE_SI256, _mm256_set1_epi16, _mm256_min_epi16,
+                   _mm256_max_epi16)
+DEFINE_MINMAX_AVX2(u16, uint16_t, __m256i, LOAD_SI256, STORE_SI256, _mm256_set1_epi16, _mm256_min_epu16,
+                   _mm256_max_epu16)
+DEFINE_MINMAX_AVX2(i32, int32_t, __m256i, LOAD_SI256, STORE_SI256, _mm256_set1_epi32, _mm256_min_epi32,
+                   _mm256_max_epi32)
+DEFINE_MINMAX_AVX2(u32, uint32_t, __m256i, LOAD_SI256, STORE_SI256, _mm256_set1_epi32, _mm256_min_epu32,
+                   _mm256_max_epu32)
+DEFINE_MINMAX_AVX2(f32, float, __m256, LOAD_PS, STORE_PS, _mm256_set1_ps, _mm256_min_ps, _mm256_max_ps)
+DEFINE_MINMAX_AVX2(f64, double, __m256d, LOAD_PD, STORE_PD, _mm256_set1_pd, _mm256_min_pd, _mm256_max_pd)
+
+#endif // ALGO_X86
+
+//// dispatch
+
+static size_t find_index(const uint8_t *data, size_t n, size_t type_size, const void *value) {
+#ifdef ALGO_X86
+    if (have_avx2()) {
+        switch (type_size) {
+        case 1:
+            return find_avx2_1(data, n, value);
+        case 2:
+            return find_avx2_2(data, n, value);
+        case 4:
+            return find_avx2_4(data, n, value);
+        case 8:
+            return find_avx2_8(data, n, value);
+        }
+    }
+#ifdef __SSE2__
+    switch (type_size) {
+    case 1:
+        return find_sse2_1(data, n, value);
+    case 2:
+        return find_sse2_2(data, n, value);
+    case 4:
+        return find_sse2_4(data, n, value);
+    case 8:
+        return find_sse2_8(data, n, value);
+    }
+#endif
+#endif
+    return find_scalar(data, n, type_size, value);
+}
+
+void *array_list_vfind(void *list, const void *value) {
+    size_t type_size = array_list_type_size(list);
+    size_t n = array_list_size(list);
+    size_t idx = find_index((const uint8_t *)list, n, type_size, value);
+    return (uint8_t *)list + idx * type_size;
+}
+
+bool array_list_vcontains(void *list, const void *value) { return array_list_vfind(list, value) != array_list_vend(list); }
+
+size_t array_list_vcount(void *list, const void *value) {
+    const uint8_t *data = (const uint8_t *)list;
+    size_t type_size = array_list_type_size(list);
+    size_t n = array_list_size(list);
+
+#ifdef ALGO_X86
+    if (have_avx2()) {
+        switch (type_size) {
+        case 1:
+            return count_avx2_1(data, n, value);
+        case 2:
+            return count_avx2_2(data, n, value);
+        case 4:
+            return count_avx2_4(data, n, value);
+        case 8:
+            return count_avx2_8(data, n, value);
+        }
+    }
+#ifdef __SSE2__
+    switch (type_size) {
+    case 1:
+        return count_sse2_1(data, n, value);
+    case 2:
+        return count_sse2_2(data, n, value);
+    case 4:
+        return count_sse2_4(data, n, value);
+    case 8:
+        return count_sse2_8(data, n, value);
+    }
+#endif
+#endif
+    return count_scalar(data, n, type_size, value);
+}
+
+void array_list_vsum(void *list, array_list_kind_t kind, void *out) {
+    size_t n = array_list_size(list);
+
+#ifdef ALGO_X86
+    if (have_avx2()) {
+        switch (kind) {
+        case ARRAY_LIST_I32:
+            *(int64_t *)out = sum_avx2_i32((const int32_t *)list, n);
+            return;
+        case ARRAY_LIST_U32:
+            *(uint64_t *)out = (uint64_t)sum_avx2_u32((const uint32_t *)list, n);
+            return;
+        case ARRAY_LIST_I64:
+            *(int64_t *)out = sum_avx2_64((const int64_t *)list, n);
+            return;
+        case ARRAY_LIST_U64:
+            *(uint64_t *)out = (uint64_t)sum_avx2_64((const int64_t *)list, n);
+            return;
+        case ARRAY_LIST_F32:
+            *(double *)out = sum_avx2_f32((const float *)list, n);
+            return;
+        case ARRAY_LIST_F64:
+            *(double *)out = sum_avx2_f64((const double *)list, n);
+            return;
+        default:
+            break;
+        }
+    }
+#endif
+
+    switch (kind) {
+    case ARRAY_LIST_I8:
+        *(int64_t *)out = sum_scalar_i8((const int8_t *)list, n);
+        break;
+    case ARRAY_LIST_U8:
+        *(uint64_t *)out = sum_scalar_u8((const uint8_t *)list, n);
+        break;
+    case ARRAY_LIST_I16:
+        *(int64_t *)out = sum_scalar_i16((const int16_t *)list, n);
+        break;
+    case ARRAY_LIST_U16:
+        *(uint64_t *)out = sum_scalar_u16((const uint16_t *)list, n);
+        break;
+    case ARRAY_LIST_I32:
+        *(int64_t *)out = sum_scalar_i32((const int32_t *)list, n);
+        break;
+    case ARRAY_LIST_U32:
+        *(uint64_t *)out = sum_scalar_u32((const uint32_t *)list, n);
+        break;
+    case ARRAY_LIST_I64:
+        *(int64_t *)out = sum_scalar_i64((const int64_t *)list, n);
+        break;
+    case ARRAY_LIST_U64:
+        *(uint64_t *)out = sum_scalar_u64((const uint64_t *)list, n);
+        break;
+    case ARRAY_LIST_F32:
+        *(double *)out = sum_scalar_f32((const float *)list, n);
+        break;
+    case ARRAY_LIST_F64:
+        *(double *)out = sum_scalar_f64((const double *)list, n);
+        break;
+    }
+}
+
+bool array_list_vmin_max(void *list, array_list_kind_t kind, void *min, void *max) {
+    size_t n = array_list_size(list);
+    if (n == 0)
+        return false;
+
+#ifdef ALGO_X86
+#define MINMAX_KERNEL(name) (have_avx2() ? minmax_avx2_##name : minmax_scalar_##name)
+#else
+#define MINMAX_KERNEL(name) minmax_scalar_##name
+#endif
+
+#define MINMAX_CASE(kind_id, T, kernel)                                                                                \
+    case kind_id: {                                                                                                    \
+        const T *p = (const T *)list;                                                                                  \
+        T lo = p[0], hi = p[0];                                                                                        \
+        kernel(p + 1, n - 1, &lo, &hi);                                                                                \
+        if (min)                                                                                                       \
+            *(T *)min = lo;                                                                                            \
+        if (max)                                                                                                       \
+            *(T *)max = hi;                                                                                            \
+        break;                                                                                                         \
+    }
+
+    switch (kind) {
+        MINMAX_CASE(ARRAY_LIST_I8, int8_t, MINMAX_KERNEL(i8))
+        MINMAX_CASE(ARRAY_LIST_U8, uint8_t, MINMAX_KERNEL(u8))
+        MINMAX_CASE(ARRAY_LIST_I16, int16_t, MINMAX_KERNEL(i16))
+        MINMAX_CASE(ARRAY_LIST_U16, uint16_t, MINMAX_KERNEL(u16))
+        MINMAX_CASE(ARRAY_LIST_I32, int32_t, MINMAX_KERNEL(i32))
+        MINMAX_CASE(ARRAY_LIST_U32, uint32_t, MINMAX_KERNEL(u32))
+        MINMAX_CASE(ARRAY_LIST_I64, int64_t, minmax_scalar_i64)
+        MINMAX_CASE(ARRAY_LIST_U64, uint64_t, minmax_scalar_u64)
+        MINMAX_CASE(ARRAY_LIST_F32, float, MINMAX_KERNEL(f32))
+        MINMAX_CASE(ARRAY_LIST_F64, double, MINMAX_KERNEL(f64))
+    }
+
+#undef MINMAX_CASE
+#undef MINMAX_KERNEL
+    return true;
+}
+
+//// sorting
+
+#define SORT_RUN 32
+#define SORT_MAX_THREADS 64
+// below this many elements per thread, spinning up threads costs more than it saves
+#define SORT_PARALLEL_MIN 8192
+
+typedef int (*sort_cmp_t)(const void *, const void *);
+
+static void insertion_sort(uint8_t *data, size_t n, size_t size, sort_cmp_t cmp, uint8_t *hold) {
+    for (size_t i = 1; i < n; i++) {
+        memcpy(hold, data + i * size, size);
+        size_t j = i;
+        while (j > 0 && cmp(data + (j - 1) * size, hold) > 0) {
+            memcpy(data + j * size, data + (j - 1) * size, size);
+            j--;
+        }
+        memcpy(data + j * size, hold, size);
+    }
+}
+
+// Stable merge of two sorted runs into `out`, ties take from `a` first.
+static void merge_runs(const uint8_t *a, size_t na, const uint8_t *b, size_t nb, uint8_t *out, size_t size,
+                       sort_cmp_t cmp) {
+    while (na && nb) {
+        if (cmp(b, a) < 0) {
+            memcpy(out, b, size);
+            b += size;
+            nb--;
+        } else {
+            memcpy(out, a, size);
+            a += size;
+            na--;
+        }
+        out += size;
+    }
+    memcpy(out, a, na * size);
+    memcpy(out + na * size, b, nb * size);
+}
+
+// Bottom-up merge sort of `data` using `tmp` (same length) as scratch, the result always ends up in `data`.
+static void merge_sort(uint8_t *data, uint8_t *tmp, size_t n, size_t size, sort_cmp_t cmp) {
+    for (size_t i = 0; i < n; i += SORT_RUN)
+        insertion_sort(data + i * size, n - i < SORT_RUN ? n - i : SORT_RUN, size, cmp, tmp);
+
+    uint8_t *src = data, *dst = tmp;
+    for (size_t width = SORT_RUN; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            merge_runs(src + lo * size, mid - lo, src + mid * size, hi - mid, dst + lo * size, size, cmp);
+        }
+        uint8_t *swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != data)
+        memcpy(data, src, n * size);
+}
+
+// Returns how many elements of `a` come before output position `k` when merging `a` and `b` stably.
+static size_t merge_corank(const uint8_t *a, size_t na, const uint8_t *b, size_t nb, size_t k, size_t size,
+                           sort_cmp_t cmp) {
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = k < na ? k : na;
+
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        size_t j = k - i;
+        if (j > 0 && i < na && cmp(b + (j - 1) * size, a + i * size) >= 0)
+            lo = i + 1; // b[j - 1] can't come before a[i], so more of a is needed
+        else
+            hi = i;
+    }
+    return lo;
+}
+
+void array_list_sort(void *list, int (*cmp)(const void *, const void *)) {
+    size_t n = array_list_size(list);
+    size_t size = array_list_type_size(list);
+    if (n < 2)
+        return;
+
+    uint8_t *tmp = (uint8_t *)malloc(n * size);
+    assert(tmp != NULL && "failed to allocate scratch space when sorting");
+    merge_sort((uint8_t *)list, tmp, n, size, cmp);
+    free(tmp);
+}
+
+#ifdef SORT_THREADS
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    size_t count;
+    size_t waiting;
+    size_t generation;
+} sort_barrier_t;
+
+typedef struct {
+    uint8_t *data;
+    uint8_t *tmp;
+    size_t n;
+    size_t size;
+    size_t threads;
+    sort_cmp_t cmp;
+    sort_barrier_t barrier;
+} sort_job_t;
+
+typedef struct {
+    sort_job_t *job;
+    size_t id;
+} sort_worker_t;
+
+// pthread barriers are optional in POSIX (and missing on macOS), so roll a tiny one
+static void barrier_wait(sort_barrier_t *b) {
+    pthread_mutex_lock(&b->lock);
+    size_t gen = b->generation;
+    if (++b->waiting == b->count) {
+        b->waiting = 0;
+        b->generation++;
+        pthread_cond_broadcast(&b->cond);
+    } else {
+        while (gen == b->generation)
+            pthread_cond_wait(&b->cond, &b->lock);
+    }
+    pthread_mutex_unlock(&b->lock);
+}
+
+#define chunk_start(n, parts, i) ((n) * (i) / (parts))
+
+static void *sort_worker(void *arg) {
+    sort_worker_t *w = (sort_worker_t *)arg;
+    sort_job_t *job = w->job;
+    size_t size = job->size, t = job->threads, id = w->id;
+
+    // every thread sorts its own chunk
+    size_t lo = chunk_start(job->n, t, id), hi = chunk_start(job->n, t, id + 1);
+    merge_sort(job->data + lo * size, job->tmp + lo * size, hi - lo, size, job->cmp);
+    barrier_wait(&job->barrier);
+
+    // then runs are merged pairwise, every thread taking an equal slice of the output of one pair each round
+    uint8_t *src = job->data, *dst = job->tmp;
+    for (size_t span = 1; span < t; span *= 2) {
+        size_t per_pair = span * 2;
+        size_t pair = id / per_pair, part = id % per_pair;
+
+        size_t a_lo = chunk_start(job->n, t, pair * per_pair);
+        size_t b_lo = chunk_start(job->n, t, pair * per_pair + span);
+        size_t b_hi = chunk_start(job->n, t, pair * per_pair + per_pair);
+        size_t na = b_lo - a_lo, nb = b_hi - b_lo, total = na + nb;
+
+        const uint8_t *a = src + a_lo * size, *b = src + b_lo * size;
+        size_t k_lo = chunk_start(total, per_pair, part), k_hi = chunk_start(total, per_pair, part + 1);
+        size_t i_lo = merge_corank(a, na, b, nb, k_lo, size, job->cmp);
+        size_t i_hi = merge_corank(a, na, b, nb, k_hi, size, job->cmp);
+
+        merge_runs(a + i_lo * size, i_hi - i_lo, b + (k_lo - i_lo) * size, (k_hi - i_hi) - (k_lo - i_lo),
+                   dst + (a_lo + k_lo) * size, size, job->cmp);
+
+        uint8_t *swap = src;
+        src = dst;
+        dst = swap;
+        barrier_wait(&job->barrier);
+    }
+
+    if (src != job->data)
+        memcpy(job->data + lo * size, src + lo * size, (hi - lo) * size);
+    return NULL;
+}
+
+// Workers are spawned on the first parallel sort that needs them and then kept around for the life of the process,
+// each sleeping on its own slot between sorts. A sort hands its job to slots `1..t-1` only, so workers spawned for a
+// wider sort stay asleep. Only one sort drives the pool at a time (`busy`), a sort that finds it taken runs on its
+// calling thread instead, as the CPUs are already being kept busy by the other one.
+typedef struct {
+    size_t id;
+    sort_job_t *job; // set while the slot has work, cleared by the worker once it is done
+    pthread_cond_t wake;
+} sort_slot_t;
+
+static struct {
+    pthread_mutex_t busy;
+    pthread_mutex_t lock; // guards everything below
+    pthread_cond_t done;
+    size_t spawned;
+    size_t remaining;
+    sort_slot_t slots[SORT_MAX_THREADS];
+} sort_pool = { .busy = PTHREAD_MUTEX_INITIALIZER,
+                .lock = PTHREAD_MUTEX_INITIALIZER,
+                .done = PTHREAD_COND_INITIALIZER };
+
+static void *sort_pool_thread(void *arg) {
+    sort_slot_t *slot = (sort_slot_t *)arg;
+
+    pthread_mutex_lock(&sort_pool.lock);
+    for (;;) {
+        while (slot->job == NULL)
+            pthread_cond_wait(&slot->wake, &sort_pool.lock);
+        sort_job_t *job = slot->job;
+
+        pthread_mutex_unlock(&sort_pool.lock);
+        sort_worker_t w = { job, slot->id };
+        sort_worker(&w);
+        pthread_mutex_lock(&sort_pool.lock);
+
+        slot->job = NULL;
+        if (--sort_pool.remaining == 0)
+            pthread_cond_signal(&sort_pool.done);
+    }
+    return NULL;
+}
+
+// Makes sure workers `1..t-1` exist, returns how many threads (a power of two, at most `t`) the sort can really use.
+// Must be called with `sort_pool.lock` held.
+static size_t sort_pool_grow(size_t t) {
+    while (sort_pool.spawned + 1 < t) {
+        sort_slot_t *slot = &sort_pool.slots[sort_pool.spawned + 1];
+        slot->id = sort_pool.spawned + 1;
+        slot->job = NULL;
+        pthread_cond_init(&slot->wake, NULL);
+
+        pthread_t handle;
+        if (pthread_create(&handle, NULL, sort_pool_thread, slot) != 0) {
+            pthread_cond_destroy(&slot->wake);
+            break;
+        }
+        pthread_detach(handle);
+        sort_pool.spawned++;
+    }
+
+    while (t > sort_pool.spawned + 1)
+        t /= 2;
+    return t;
+}
+
+// Runs `job` on the calling thread plus pool workers `1..job->threads-1`, returns once every worker is done.
+// Must be called with `sort_pool.busy` held.
+static void sort_pool_run(sort_job_t *job) {
+    pthread_mutex_lock(&sort_pool.lock);
+    sort_pool.remaining = job->threads - 1;
+    for (size_t i = 1; i < job->threads; i++) {
+        sort_pool.slots[i].job = job;
+        pthread_cond_signal(&sort_pool.slots[i].wake);
+    }
+    pthread_mutex_unlock(&sort_pool.lock);
+
+    sort_worker_t w = { job, 0 };
+    sort_worker(&w);
+
+    pthread_mutex_lock(&sort_pool.lock);
+    while (sort_pool.remaining > 0)
+        pthread_cond_wait(&sort_pool.done, &sort_pool.lock);
+    pthread_mutex_unlock(&sort_pool.lock);
+}
+#endif // SORT_THREADS
+
+void array_list_sort_parallel(void *list, int (*cmp)(const void *, const void *), size_t threads) {
+    size_t n = array_list_size(list);
+    size_t size = array_list_type_size(list);
+
+#ifdef SORT_THREADS
+    if (threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+
+    // the merge rounds pair runs up, so stick to a power of two
+    size_t t = 1;
+    while (t * 2 <= threads && t * 2 <= SORT_MAX_THREADS && n / (t * 2) >= SORT_PARALLEL_MIN)
+        t *= 2;
+
+    if (t > 1 && pthread_mutex_trylock(&sort_pool.busy) == 0) {
+        pthread_mutex_lock(&sort_pool.lock);
+        t = sort_pool_grow(t);
+        pthread_mutex_unlock(&sort_pool.lock);
+
+        if (t > 1) {
+            sort_job_t job = { (uint8_t *)list, NULL, n, size, t, cmp, { .count = t } };
+            job.tmp = (uint8_t *)malloc(n * size);
+            assert(job.tmp != NULL && "failed to allocate scratch space when sorting");
+            pthread_mutex_init(&job.barrier.lock, NULL);
+            pthread_cond_init(&job.barrier.cond, NULL);
+
+            sort_pool_run(&job);
+
+            pthread_cond_destroy(&job.barrier.cond);
+            pthread_mutex_destroy(&job.barrier.lock);
+            free(job.tmp);
+            pthread_mutex_unlock(&sort_pool.busy);
+            return;
+        }
+        pthread_mutex_unlock(&sort_pool.busy);
+    }
+#else
+    (void)threads;
+#endif
+
+    if (n < 2)
+        return;
+    uint8_t *tmp = (uint8_t *)malloc(n * size);
+    assert(tmp != NULL && "failed to allocate scratch space when sorting");
+    merge_sort((uint8_t *)list, tmp, n, size, cmp);
+    free(tmp);
+}
+
+// Radix sort works on unsigned keys, so signed and float keys are flipped into an order-preserving unsigned form
+// before sorting and flipped back after.
+#define DEFINE_RADIX(bits)                                                                                             \
+    static void radix_to_ordered_##bits(uint##bits##_t *p, size_t n, bool is_signed, bool is_float) {                 \
+        const uint##bits##_t sign = (uint##bits##_t)1 << (bits - 1);                                                   \
+        if (is_float) {                                                                                                \
+            for (size_t i = 0; i < n; i++)                                                                             \
+                p[i] = (p[i] & sign) ? (uint##bits##_t) ~p[i] : (uint##bits##_t)(p[i] | sign);                         \
+        } else if (is_signed) {                                                                                        \
+            for (size_t i = 0; i < n; i++)                                                                             \
+                p[i] ^= sign;                                                                                          \
+        }                                                                                                              \
+    }                                                                                                                  \
+    static void radix_from_ordered_##bits(uint##bits##_t *p, size_t n, bool is_signed, bool is_float) {               \
+        const uint##bits##_t sign = (uint##bits##_t)1 << (bits - 1);                                                   \
+        if (is_float) {                                                                                                \
+            for (size_t i = 0; i < n; i++)                                                                             \
+                p[i] = (p[i] & sign) ? (uint##bits##_t)(p[i] ^ sign) : (uint##bits##_t) ~p[i];                         \
+        } else if (is_signed) {                                                                                        \
+            for (size_t i = 0; i < n; i++)                                                                             \
+                p[i] ^= sign;                                                                                          \
+        }                                                                                                              \
+    }                                                                                                                  \
+    static void radix_sort_##bits(uint##bits##_t *data, uint##bits##_t *tmp, size_t n) {                              \
+        size_t counts[bits / 8][256];                                                                                  \
+        memset(counts, 0, sizeof(counts));                                                                             \
+        for (size_t i = 0; i < n; i++)                                                                                 \
+            for (size_t d = 0; d < bits / 8; d++)                                                                      \
+                counts[d][(data[i] >> (d * 8)) & 0xFF]++;                                                              \
+                                                                                                                       \
+        uint##bits##_t *src = data, *dst = tmp;                                                                        \
+        for (size_t d = 0; d < bits / 8; d++) {                                                                        \
+            size_t offsets[256], sum = 0;                                                                              \
+            bool trivial = false;                                                                                      \
+            for (size_t b = 0; b < 256; b++) {                                                                         \
+                trivial |= counts[d][b] == n;                                                                          \
+                offsets[b] = sum;                                                                                      \
+                sum += counts[d][b];                                                                                   \
+            }                                                                                                          \
+            if (trivial) /* every key shares this digit, the pass would be a plain copy */                             \
+                continue;                                                                                              \
+                                                                                                                       \
+            for (size_t i = 0; i < n; i++)                                                                             \
+                dst[offsets[(src[i] >> (d * 8)) & 0xFF]++] = src[i];                                                   \
+            uint##bits##_t *swap = src;                                                                                \
+            src = dst;                                                                                                 \
+            dst = swap;                                                                                                \
+        }                                                                                                              \
+                                                                                                                       \
+        if (src != data)                                                                                               \
+            memcpy(data, src, n * sizeof(uint##bits##_t));                                                             \
+    }
+
+DEFINE_RADIX(8)
+DEFINE_RADIX(16)
+DEFINE_RADIX(32)
+DEFINE_RADIX(64)
+
+static size_t radix_kind_size(array_list_kind_t kind) {
+    switch (kind) {
+    case ARRAY_LIST_I8:
+    case ARRAY_LIST_U8:
+        return 1;
+    case ARRAY_LIST_I16:
+    case ARRAY_LIST_U16:
+        return 2;
+    case ARRAY_LIST_I32:
+    case ARRAY_LIST_U32:
+    case ARRAY_LIST_F32:
+        return 4;
+    default:
+        return 8;
+    }
+}
+
+bool array_list_sort_radix(void *list, array_list_kind_t kind) {
+    size_t n = array_list_size(list);
+    size_t size = radix_kind_size(kind);
+    if (array_list_type_size(list) != size)
+        return false;
+    if (n < 2)
+        return true;
+
+    bool is_float = kind == ARRAY_LIST_F32 || kind == ARRAY_LIST_F64;
+    bool is_signed = kind == ARRAY_LIST_I8 || kind == ARRAY_LIST_I16 || kind == ARRAY_LIST_I32 || kind == ARRAY_LIST_I64;
+
+    void *tmp = malloc(n * size);
+    assert(tmp != NULL && "failed to allocate scratch space when sorting");
+
+#define RADIX_CASE(bits)                                                                                               \
+    case bits / 8:                                                                                                     \
+        radix_to_ordered_##bits((uint##bits##_t *)list, n, is_signed, is_float);                                       \
+        radix_sort_##bits((uint##bits##_t *)list, (uint##bits##_t *)tmp, n);                                           \
+        radix_from_ordered_##bits((uint##bits##_t *)list, n, is_signed, is_float);                                     \
+        break;
+
+    // the size comes from `kind`, so it is always one of these
+    switch (size) {
+        RADIX_CASE(8)
+        RADIX_CASE(16)
+        RADIX_CASE(32)
+        RADIX_CASE(64)
+    }
+
+#undef RADIX_CASE
+    free(tmp);
+    return true;
+}
+
+static bool have_avx2(void) {
+#ifdef ALGO_X86
+    // -1 until the first call probes the CPU, racing threads just probe twice
+    static int supported = -1;
+    int cached = __atomic_load_n(&supported, __ATOMIC_RELAXED);
+    if (cached < 0) {
+        __builtin_cpu_init();
+        cached = __builtin_cpu_supports("avx2") ? 1 : 0;
+        __atomic_store_n(&supported, cached, __ATOMIC_RELAXED);
+    }
+    return cached == 1;
+#else
+    return false;
+#endif
+}
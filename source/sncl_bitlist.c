@@ -0,0 +1,175 @@
+#include <sncl_bitlist.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    size_t size;       // entries, not words
+    size_t capacity;   // words
+    unsigned width;    // bits per entry, 1 for bit lists
+    unsigned per_word; // entries per word
+    uint64_t words[];
+} bitlist_t;
+
+static bitlist_t *header_of(const uint64_t *words) {
+    return (bitlist_t *)((uint8_t *)words - offsetof(bitlist_t, words));
+}
+
+static uint64_t *create(unsigned width, size_t init_cap);
+static void reserve_words(uint64_t **words, size_t count);
+static void clear_tail(bitlist_t *L);
+
+uint64_t *bit_list_create(size_t init_cap) { return create(1, init_cap); }
+
+void bit_list_destroy(uint64_t *bits) { free(header_of(bits)); }
+
+size_t bit_list_size(const uint64_t *bits) { return header_of(bits)->size; }
+
+size_t bit_list_word_count(const uint64_t *bits) { return (header_of(bits)->size + 63) / 64; }
+
+bool bit_list_get(const uint64_t *bits, size_t idx) {
+    assert(idx < header_of(bits)->size && "bit list index out of range");
+    return (bits[idx / 64] >> (idx % 64)) & 1;
+}
+
+void bit_list_set(uint64_t *bits, size_t idx, bool value) {
+    assert(idx < header_of(bits)->size && "bit list index out of range");
+    uint64_t mask = (uint64_t)1 << (idx % 64);
+    bits[idx / 64] = (bits[idx / 64] & ~mask) | (-(uint64_t)value & mask);
+}
+
+void bit_list_vpush_back(uint64_t **bits, bool value) {
+    bitlist_t *L = header_of(*bits);
+    if (L->size == L->capacity * 64) {
+        reserve_words(bits, L->capacity ? L->capacity * 2 : 1);
+        L = header_of(*bits);
+    }
+
+    size_t idx = L->size++;
+    if (idx % 64 == 0)
+        (*bits)[idx / 64] = 0;
+    (*bits)[idx / 64] |= (uint64_t)value << (idx % 64);
+}
+
+void bit_list_vresize(uint64_t **bits, size_t size) {
+    bitlist_t *L = header_of(*bits);
+    size_t old_words = (L->size + 63) / 64;
+    size_t new_words = (size + 63) / 64;
+
+    if (new_words > L->capacity) {
+        reserve_words(bits, new_words);
+        L = header_of(*bits);
+    }
+    if (new_words > old_words)
+        memset(L->words + old_words, 0, (new_words - old_words) * sizeof(uint64_t));
+
+    L->size = size;
+    clear_tail(L);
+}
+
+void bit_list_reset(uint64_t *bits) { memset(bits, 0, bit_list_word_count(bits) * sizeof(uint64_t)); }
+
+size_t bit_list_popcount(const uint64_t *bits) {
+    size_t words = bit_list_word_count(bits);
+    size_t count = 0;
+    for (size_t i = 0; i < words; i++)
+        count += (size_t)__builtin_popcountll(bits[i]);
+    return count;
+}
+
+size_t bit_list_find_first_set(const uint64_t *bits, size_t from) {
+    size_t size = header_of(bits)->size;
+    if (from >= size)
+        return size;
+
+    size_t words = bit_list_word_count(bits);
+    size_t i = from / 64;
+    uint64_t word = bits[i] & (~(uint64_t)0 << (from % 64));
+    while (word == 0) {
+        if (++i == words)
+            return size;
+        word = bits[i];
+    }
+    return i * 64 + (size_t)__builtin_ctzll(word);
+}
+
+#define DEFINE_BITWISE(name, op)                                                                                       \
+    void bit_list_##name(uint64_t *dst, const uint64_t *src) {                                                         \
+        assert(header_of(dst)->size == header_of(src)->size && "bit lists must be the same size");                   \
+        size_t words = bit_list_word_count(dst);                                                                       \
+        for (size_t i = 0; i < words; i++)                                                                             \
+            dst[i] op src[i];                                                                                          \
+    }
+
+DEFINE_BITWISE(and, &=)
+DEFINE_BITWISE(or, |=)
+DEFINE_BITWISE(xor, ^=)
+
+uint64_t *packed_list_create(unsigned width, size_t init_cap) {
+    assert(width >= 1 && width <= 7 && "packed list entries must be 1 to 7 bits wide");
+    return create(width, init_cap);
+}
+
+void packed_list_destroy(uint64_t *list) { free(header_of(list)); }
+
+size_t packed_list_size(const uint64_t *list) { return header_of(list)->size; }
+
+unsigned packed_list_width(const uint64_t *list) { return header_of(list)->width; }
+
+unsigned packed_list_get(const uint64_t *list, size_t idx) {
+    bitlist_t *L = header_of(list);
+    assert(idx < L->size && "packed list index out of range");
+    unsigned shift = (unsigned)(idx % L->per_word) * L->width;
+    return (unsigned)(list[idx / L->per_word] >> shift) & ((1u << L->width) - 1);
+}
+
+void packed_list_set(uint64_t *list, size_t idx, unsigned value) {
+    bitlist_t *L = header_of(list);
+    assert(idx < L->size && "packed list index out of range");
+    assert(value < (1u << L->width) && "value does not fit in the packed list entry width");
+
+    unsigned shift = (unsigned)(idx % L->per_word) * L->width;
+    uint64_t mask = (((uint64_t)1 << L->width) - 1) << shift;
+    list[idx / L->per_word] = (list[idx / L->per_word] & ~mask) | ((uint64_t)value << shift);
+}
+
+void packed_list_vpush_back(uint64_t **list, unsigned value) {
+    bitlist_t *L = header_of(*list);
+    if (L->size == L->capacity * L->per_word) {
+        reserve_words(list, L->capacity ? L->capacity * 2 : 1);
+        L = header_of(*list);
+    }
+
+    size_t idx = L->size++;
+    if (idx % L->per_word == 0)
+        (*list)[idx / L->per_word] = 0;
+    packed_list_set(*list, idx, value);
+}
+
+static uint64_t *create(unsigned width, size_t init_cap) {
+    unsigned per_word = 64 / width;
+    size_t capacity = (init_cap + per_word - 1) / per_word;
+
+    bitlist_t *L = (bitlist_t *)malloc(sizeof(bitlist_t) + capacity * sizeof(uint64_t));
+    assert(L != NULL && "failed to allocate bit list when instantiating");
+    L->size = 0;
+    L->capacity = capacity;
+    L->width = width;
+    L->per_word = per_word;
+    return L->words;
+}
+
+static void reserve_words(uint64_t **words, size_t count) {
+    bitlist_t *L = (bitlist_t *)realloc(header_of(*words), sizeof(bitlist_t) + count * sizeof(uint64_t));
+    assert(L != NULL && "failed to allocate new bit list when growing");
+    L->capacity = count;
+    *words = L->words;
+}
+
+// Clears the bits past the last entry of the last word, which whole-word scans rely on.
+static void clear_tail(bitlist_t *L) {
+    size_t used = L->size % L->per_word;
+    if (used != 0)
+        L->words[L->size / L->per_word] &= ((uint64_t)1 << (used * L->width)) - 1;
+}
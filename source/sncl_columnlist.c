@@ -0,0 +1,154 @@
+#include <sncl_columnlist.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COLUMN_ALIGNMENT ((size_t)64)
+
+typedef struct {
+    uint8_t *block;   // the allocation every column lives in
+    uint8_t **columns;
+    column_list_field_t *fields;
+    size_t field_count;
+    size_t row_size;
+    size_t capacity;
+    size_t size;
+} columnlist_t;
+
+#define round_up(n) (((n) + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT)
+
+static void relayout(columnlist_t *C, size_t cap);
+
+void *column_list__create(const column_list_field_t *fields, size_t field_count, size_t row_size, size_t init_cap) {
+    columnlist_t *C = (columnlist_t *)malloc(sizeof(columnlist_t));
+    if (!C)
+        return NULL;
+
+    C->fields = (column_list_field_t *)malloc(field_count * sizeof(column_list_field_t));
+    C->columns = (uint8_t **)calloc(field_count ? field_count : 1, sizeof(uint8_t *));
+    assert(C->fields != NULL && C->columns != NULL && "failed to allocate column list");
+    for (size_t f = 0; f < field_count; f++)
+        assert(fields[f].offset + fields[f].size <= row_size && "column list field lies outside of the row");
+
+    memcpy(C->fields, fields, field_count * sizeof(column_list_field_t));
+    C->field_count = field_count;
+    C->row_size = row_size;
+    C->block = NULL;
+    C->capacity = 0;
+    C->size = 0;
+    relayout(C, init_cap);
+    return (void *)C;
+}
+
+void column_list__destroy(void *cl) {
+    columnlist_t *C = cl;
+    free(C->block);
+    free(C->columns);
+    free(C->fields);
+    free(C);
+}
+
+bool column_list_empty(void *cl) {
+    columnlist_t *C = cl;
+    return C->size == 0;
+}
+
+size_t column_list_size(void *cl) {
+    columnlist_t *C = cl;
+    return C->size;
+}
+
+size_t column_list_capacity(void *cl) {
+    columnlist_t *C = cl;
+    return C->capacity;
+}
+
+size_t column_list_column_count(void *cl) {
+    columnlist_t *C = cl;
+    return C->field_count;
+}
+
+void *column_list_column(void *cl, size_t col) {
+    columnlist_t *C = cl;
+    assert(col < C->field_count && "column list column out of range");
+    return C->columns[col];
+}
+
+void column_list__get_row(void *cl, size_t idx, void *row) {
+    columnlist_t *C = cl;
+    assert(idx < C->size && "column list row out of range");
+
+    memset(row, 0, C->row_size);
+    for (size_t f = 0; f < C->field_count; f++) {
+        size_t size = C->fields[f].size;
+        memcpy((uint8_t *)row + C->fields[f].offset, C->columns[f] + idx * size, size);
+    }
+}
+
+void column_list__push_row(void *cl, const void *row) {
+    columnlist_t *C = cl;
+    if (C->size == C->capacity)
+        relayout(C, C->capacity ? C->capacity * 2 : 1);
+
+    C->size++;
+    column_list__set_row(cl, C->size - 1, row);
+}
+
+void column_list__set_row(void *cl, size_t idx, const void *row) {
+    columnlist_t *C = cl;
+    assert(idx < C->size && "column list row out of range");
+
+    for (size_t f = 0; f < C->field_count; f++) {
+        size_t size = C->fields[f].size;
+        memcpy(C->columns[f] + idx * size, (const uint8_t *)row + C->fields[f].offset, size);
+    }
+}
+
+void column_list_swap_remove(void *cl, size_t idx) {
+    columnlist_t *C = cl;
+    assert(idx < C->size && "column list row out of range");
+
+    C->size--;
+    if (idx == C->size)
+        return;
+    for (size_t f = 0; f < C->field_count; f++) {
+        size_t size = C->fields[f].size;
+        memcpy(C->columns[f] + idx * size, C->columns[f] + C->size * size, size);
+    }
+}
+
+void column_list_clear(void *cl) {
+    columnlist_t *C = cl;
+    C->size = 0;
+}
+
+void column_list_reserve(void *cl, size_t cap) {
+    columnlist_t *C = cl;
+    if (cap > C->capacity)
+        relayout(C, cap);
+}
+
+// Moves every column into a fresh block sized for `cap` rows. Columns are laid out one after another, each rounded up
+// to a cache line so no two columns share one and every column is aligned for vector loads.
+static void relayout(columnlist_t *C, size_t cap) {
+    size_t total = 0;
+    for (size_t f = 0; f < C->field_count; f++)
+        total += round_up(C->fields[f].size * cap);
+
+    uint8_t *block = (uint8_t *)malloc(total + COLUMN_ALIGNMENT);
+    assert(block != NULL && "failed to allocate column list when growing");
+
+    uint8_t *at = (uint8_t *)round_up((uintptr_t)block);
+    for (size_t f = 0; f < C->field_count; f++) {
+        if (C->size)
+            memcpy(at, C->columns[f], C->fields[f].size * C->size);
+        C->columns[f] = at;
+        at += round_up(C->fields[f].size * cap);
+    }
+
+    free(C->block);
+    C->block = block;
+    C->capacity = cap;
+}
@@ -0,0 +1,155 @@
+#include <sncl_deque.h>
+
+#include <sncl_arraylist.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint8_t *buffer; // arraylist whose whole capacity is the ring, its size is never used
+    size_t head;     // index of the front element
+    size_t mask;     // capacity - 1, the capacity is always a power of two
+    size_t size;
+    size_t type_size;
+} deque_t;
+
+#define slot_of(D, idx) ((D)->buffer + (((D)->head + (idx)) & (D)->mask) * (D)->type_size)
+
+static void grow(deque_t *D, size_t cap);
+
+void *deque__create(size_t type_size, size_t init_cap) {
+    deque_t *D = (deque_t *)malloc(sizeof(deque_t));
+    if (!D)
+        return NULL;
+
+    size_t cap = 1;
+    while (cap < init_cap)
+        cap <<= 1;
+
+    D->buffer = (uint8_t *)array_list_create(type_size, cap);
+    D->head = 0;
+    D->mask = cap - 1;
+    D->size = 0;
+    D->type_size = type_size;
+    return (void *)D;
+}
+
+void deque__destroy(void *dq) {
+    deque_t *D = dq;
+    array_list_destroy((void *)D->buffer);
+    free(D);
+}
+
+void *deque__at(void *dq, size_t idx) {
+    deque_t *D = dq;
+    if (idx >= D->size)
+        return NULL;
+    return slot_of(D, idx);
+}
+
+void *deque__front(void *dq) { return deque__at(dq, 0); }
+
+void *deque__back(void *dq) {
+    deque_t *D = dq;
+    if (D->size == 0)
+        return NULL;
+    return deque__at(dq, D->size - 1);
+}
+
+bool deque_empty(void *dq) {
+    deque_t *D = dq;
+    return D->size == 0;
+}
+
+size_t deque_size(void *dq) {
+    deque_t *D = dq;
+    return D->size;
+}
+
+size_t deque_capacity(void *dq) {
+    deque_t *D = dq;
+    return D->mask + 1;
+}
+
+void deque_spans(void *dq, void **first, size_t *first_count, void **second, size_t *second_count) {
+    deque_t *D = dq;
+    size_t to_end = D->mask + 1 - D->head;
+
+    *first = D->size ? D->buffer + D->head * D->type_size : NULL;
+    *first_count = D->size < to_end ? D->size : to_end;
+    *second = D->size > to_end ? D->buffer : NULL;
+    *second_count = D->size - *first_count;
+}
+
+void *deque__push_back(void *dq, const void *val) {
+    deque_t *D = dq;
+    if (D->size > D->mask)
+        grow(D, (D->mask + 1) * 2);
+
+    uint8_t *slot = slot_of(D, D->size);
+    memcpy(slot, val, D->type_size);
+    D->size++;
+    return slot;
+}
+
+void *deque__push_front(void *dq, const void *val) {
+    deque_t *D = dq;
+    if (D->size > D->mask)
+        grow(D, (D->mask + 1) * 2);
+
+    D->head = (D->head - 1) & D->mask;
+    D->size++;
+    uint8_t *slot = slot_of(D, 0);
+    memcpy(slot, val, D->type_size);
+    return slot;
+}
+
+void deque__pop_front(void *dq) { deque_consume(dq, 1); }
+
+void deque__pop_back(void *dq) {
+    deque_t *D = dq;
+    if (D->size > 0)
+        D->size--;
+}
+
+void deque_consume(void *dq, size_t n) {
+    deque_t *D = dq;
+    if (n > D->size)
+        n = D->size;
+
+    D->head = (D->head + n) & D->mask;
+    D->size -= n;
+}
+
+void deque_clear(void *dq) {
+    deque_t *D = dq;
+    D->head = 0;
+    D->size = 0;
+}
+
+void deque_reserve(void *dq, size_t cap) {
+    deque_t *D = dq;
+    size_t new_cap = D->mask + 1;
+    while (new_cap < cap)
+        new_cap <<= 1;
+
+    if (new_cap > D->mask + 1)
+        grow(D, new_cap);
+}
+
+// Grows the ring to `cap` (a larger power of two). The arraylist reallocation keeps the bytes where they were, so the
+// only elements out of place are the ones that had wrapped around to the start of the old ring. As the ring at least
+// doubles, they always fit right after the old end.
+static void grow(deque_t *D, size_t cap) {
+    size_t old_cap = D->mask + 1;
+    array_list_reserve(D->buffer, cap);
+    assert(D->buffer != NULL && "failed to grow deque");
+
+    if (D->head + D->size > old_cap) {
+        size_t wrapped = D->head + D->size - old_cap;
+        memcpy(D->buffer + old_cap * D->type_size, D->buffer, wrapped * D->type_size);
+    }
+    D->mask = cap - 1;
+}
@@ -0,0 +1,165 @@
+#include <sncl_flatset.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define prefetch(ptr) __builtin_prefetch(ptr)
+#else
+#define prefetch(ptr) ((void)(ptr))
+#endif
+
+static size_t dedup(uint8_t *data, size_t size, size_t type_size, flat_set_cmp_t cmp);
+
+// Branchless binary search over `size` elements. Each step halves the range with a conditional move rather than a
+// branch, so there is nothing for the CPU to mispredict, and both candidates for the next midpoint are prefetched while
+// the comparison runs. With `upper` set it finds the first element greater than `key` instead.
+static size_t search(const uint8_t *data, size_t size, size_t ts, const void *key, flat_set_cmp_t cmp, bool upper) {
+    if (size == 0)
+        return 0;
+
+    const uint8_t *base = data;
+    size_t len = size;
+    while (len > 1) {
+        size_t half = len / 2;
+        prefetch(base + (len / 4) * ts);
+        prefetch(base + (half + len / 4) * ts);
+
+        int c = cmp(base + half * ts, key);
+        base = (upper ? c <= 0 : c < 0) ? base + half * ts : base;
+        len -= half;
+    }
+
+    int c = cmp(base, key);
+    return (size_t)(base - data) / ts + (upper ? c <= 0 : c < 0);
+}
+
+size_t flat_set__lower_bound(void *set, const void *key, flat_set_cmp_t cmp) {
+    return search((const uint8_t *)set, array_list_size(set), array_list_type_size(set), key, cmp, false);
+}
+
+size_t flat_set__upper_bound(void *set, const void *key, flat_set_cmp_t cmp) {
+    return search((const uint8_t *)set, array_list_size(set), array_list_type_size(set), key, cmp, true);
+}
+
+void *flat_set__find(void *set, const void *key, flat_set_cmp_t cmp) {
+    size_t ts = array_list_type_size(set);
+    size_t idx = flat_set__lower_bound(set, key, cmp);
+    if (idx == array_list_size(set))
+        return NULL;
+
+    uint8_t *elem = (uint8_t *)set + idx * ts;
+    return cmp(elem, key) == 0 ? (void *)elem : NULL;
+}
+
+void *flat_set__insert(void **set, const void *val, flat_set_cmp_t cmp, bool *inserted) {
+    size_t ts = array_list_type_size(*set);
+    size_t idx = flat_set__lower_bound(*set, val, cmp);
+    size_t size = array_list_size(*set);
+
+    if (idx < size && cmp((uint8_t *)*set + idx * ts, val) == 0) {
+        if (inserted)
+            *inserted = false;
+        return (uint8_t *)*set + idx * ts;
+    }
+
+    // `val` could live in the set itself, which growing moves and the tail shift below moves again
+    const uint8_t *src = (const uint8_t *)val;
+    bool aliased = src >= (uint8_t *)*set && src < (uint8_t *)*set + size * ts;
+    size_t src_offset = aliased ? (size_t)(src - (uint8_t *)*set) : 0;
+    if (!array_list_vemplace_back_n(set, 1)) {
+        if (inserted)
+            *inserted = false;
+        return NULL;
+    }
+
+    uint8_t *at = (uint8_t *)*set + idx * ts;
+    memmove(at + ts, at, (size - idx) * ts);
+    if (aliased)
+        src = (uint8_t *)*set + src_offset + (src_offset >= idx * ts ? ts : 0);
+    memcpy(at, src, ts);
+
+    if (inserted)
+        *inserted = true;
+    return at;
+}
+
+void *flat_set__put(void **set, const void *val, flat_set_cmp_t cmp) {
+    bool inserted;
+    uint8_t *slot = (uint8_t *)flat_set__insert(set, val, cmp, &inserted);
+    if (slot && !inserted)
+        memmove(slot, val, array_list_type_size(*set));
+    return slot;
+}
+
+size_t flat_set__insert_n(void **set, const void *vals, size_t n, flat_set_cmp_t cmp) {
+    if (n == 0)
+        return 0;
+
+    size_t ts = array_list_type_size(*set);
+    uint8_t *batch = (uint8_t *)malloc(n * ts);
+    assert(batch != NULL && "failed to allocate flat set insert batch");
+    memcpy(batch, vals, n * ts);
+
+    qsort(batch, n, ts, cmp);
+    n = dedup(batch, n, ts, cmp);
+
+    size_t old_size = array_list_size(*set);
+    if (!array_list_vemplace_back_n(set, n)) {
+        free(batch);
+        return 0;
+    }
+    uint8_t *data = (uint8_t *)*set;
+
+    // merge from the back so nothing in the set is overwritten before it has been moved. On ties the batch element is
+    // written first, landing after the existing one, so the dedup pass below keeps the existing element.
+    size_t i = old_size, j = n, w = old_size + n;
+    while (j > 0) {
+        if (i > 0 && cmp(data + (i - 1) * ts, batch + (j - 1) * ts) > 0)
+            memcpy(data + --w * ts, data + --i * ts, ts);
+        else
+            memcpy(data + --w * ts, batch + --j * ts, ts);
+    }
+    free(batch);
+
+    size_t size = dedup(data, old_size + n, ts, cmp);
+    array_list_erase(data, data + size * ts, data + (old_size + n) * ts);
+    return size - old_size;
+}
+
+bool flat_set__erase(void *set, const void *key, flat_set_cmp_t cmp) {
+    uint8_t *elem = (uint8_t *)flat_set__find(set, key, cmp);
+    if (!elem)
+        return false;
+
+    array_list_erase(set, elem, elem + array_list_type_size(set));
+    return true;
+}
+
+size_t flat_set__build(void *list, flat_set_cmp_t cmp) {
+    size_t size = array_list_size(list);
+    size_t ts = array_list_type_size(list);
+
+    qsort(list, size, ts, cmp);
+    size_t unique = dedup((uint8_t *)list, size, ts, cmp);
+    array_list_erase(list, (uint8_t *)list + unique * ts, (uint8_t *)list + size * ts);
+    return size - unique;
+}
+
+// Collapses runs of equal elements in a sorted array down to their first element, returning the new size.
+static size_t dedup(uint8_t *data, size_t size, size_t ts, flat_set_cmp_t cmp) {
+    if (size == 0)
+        return 0;
+
+    size_t write = 1;
+    for (size_t read = 1; read < size; read++) {
+        if (cmp(data + (write - 1) * ts, data + read * ts) == 0)
+            continue;
+        if (write != read)
+            memcpy(data + write * ts, data + read * ts, ts);
+        write++;
+    }
+    return write;
+}
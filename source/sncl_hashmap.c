@@ -0,0 +1,370 @@
+#include <sncl_hashmap.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Control tags. Full slots hold the low 7 bits of their hash, so the high bit alone tells full from empty or erased.
+#define CTRL_EMPTY ((uint8_t)0x80)
+#define CTRL_DELETED ((uint8_t)0xFE)
+#define is_full(c) (((c) & 0x80) == 0)
+
+#define GROUP_WIDTH 16
+#define MIN_CAPACITY 16
+
+typedef struct {
+    uint8_t *ctrl;  // `capacity + GROUP_WIDTH` tags, the last group mirrors the first so groups never wrap
+    uint8_t *slots; // `capacity` slots of `slot_size` bytes, the key first and the value at `value_offset`
+    size_t capacity;
+    size_t size;
+    size_t tombstones;
+    size_t growth_left; // insertions into empty slots left before the map has to grow or rehash
+    double max_load;
+
+    size_t key_size;
+    size_t value_size;
+    size_t value_offset;
+    size_t slot_size;
+    hash_map_hash_t hash;
+    hash_map_eq_t eq;
+} hashmap_t;
+
+#define slot_at(M, i) ((M)->slots + (i) * (M)->slot_size)
+
+static uint64_t hash_of(hashmap_t *M, const void *key);
+static void set_ctrl(hashmap_t *M, size_t i, uint8_t tag);
+static uint16_t group_match(const uint8_t *group, uint8_t tag);
+static uint16_t group_free(const uint8_t *group);
+static size_t find(hashmap_t *M, const void *key, uint64_t h);
+static size_t find_free(hashmap_t *M, uint64_t h);
+static void allocate(hashmap_t *M, size_t capacity);
+static void rehash(hashmap_t *M, size_t capacity, uint8_t **retired);
+static uint8_t *insert(hashmap_t *M, const void *key, const void *value, bool *inserted);
+static size_t usable(hashmap_t *M, size_t capacity);
+static size_t capacity_for(hashmap_t *M, size_t capacity, size_t count);
+
+void *hash_map__create(size_t key_size, size_t value_size, size_t value_offset, size_t slot_size, hash_map_hash_t hash,
+                       hash_map_eq_t eq) {
+    hashmap_t *M = (hashmap_t *)malloc(sizeof(hashmap_t));
+    if (!M)
+        return NULL;
+
+    M->size = 0;
+    M->tombstones = 0;
+    M->max_load = 0.875;
+    M->key_size = key_size;
+    M->value_size = value_size;
+    M->value_offset = value_offset;
+    M->slot_size = slot_size;
+    M->hash = hash;
+    M->eq = eq;
+    allocate(M, MIN_CAPACITY);
+    return (void *)M;
+}
+
+void hash_map__destroy(void *map) {
+    hashmap_t *M = map;
+    free(M->ctrl);
+    free(M->slots);
+    free(M);
+}
+
+void *hash_map__get(void *map, const void *key) {
+    hashmap_t *M = map;
+    size_t i = find(M, key, hash_of(M, key));
+    return i == M->capacity ? NULL : slot_at(M, i) + M->value_offset;
+}
+
+bool hash_map_empty(void *map) {
+    hashmap_t *M = map;
+    return M->size == 0;
+}
+
+size_t hash_map_size(void *map) {
+    hashmap_t *M = map;
+    return M->size;
+}
+
+size_t hash_map_capacity(void *map) {
+    hashmap_t *M = map;
+    return M->capacity;
+}
+
+bool hash_map__next(void *map, size_t *cursor, void **key, void **value) {
+    hashmap_t *M = map;
+    while (*cursor < M->capacity && !is_full(M->ctrl[*cursor]))
+        (*cursor)++;
+    if (*cursor >= M->capacity)
+        return false;
+
+    uint8_t *slot = slot_at(M, *cursor);
+    if (key)
+        *key = slot;
+    if (value)
+        *value = slot + M->value_offset;
+    (*cursor)++;
+    return true;
+}
+
+void *hash_map__put(void *map, const void *key, const void *value) {
+    return insert((hashmap_t *)map, key, value, NULL);
+}
+
+void *hash_map__emplace(void *map, const void *key, bool *inserted) {
+    return insert((hashmap_t *)map, key, NULL, inserted);
+}
+
+bool hash_map__erase(void *map, const void *key) {
+    hashmap_t *M = map;
+    size_t i = find(M, key, hash_of(M, key));
+    if (i == M->capacity)
+        return false;
+
+    // a lookup only walks past a slot if every group it loaded around it was full. If the run of used slots around
+    // this one is shorter than a group, no lookup ever did, so the slot can go straight back to empty.
+    uint16_t empty_before = group_match(M->ctrl + ((i - GROUP_WIDTH) & (M->capacity - 1)), CTRL_EMPTY);
+    uint16_t empty_after = group_match(M->ctrl + i, CTRL_EMPTY);
+    size_t run_before = empty_before ? (size_t)__builtin_clz(empty_before) - 16 : GROUP_WIDTH;
+    size_t run_after = empty_after ? (size_t)__builtin_ctz(empty_after) : GROUP_WIDTH;
+
+    if (run_before + run_after < GROUP_WIDTH) {
+        set_ctrl(M, i, CTRL_EMPTY);
+        M->growth_left++;
+    } else {
+        set_ctrl(M, i, CTRL_DELETED);
+        M->tombstones++;
+    }
+    M->size--;
+    return true;
+}
+
+void hash_map_clear(void *map) {
+    hashmap_t *M = map;
+    memset(M->ctrl, CTRL_EMPTY, M->capacity + GROUP_WIDTH);
+    M->size = 0;
+    M->tombstones = 0;
+    M->growth_left = usable(M, M->capacity);
+}
+
+void hash_map_reserve(void *map, size_t count) {
+    hashmap_t *M = map;
+    size_t cap = capacity_for(M, M->capacity, count);
+    if (cap != M->capacity)
+        rehash(M, cap, NULL);
+}
+
+void hash_map_set_max_load(void *map, double max_load) {
+    hashmap_t *M = map;
+    if (max_load < 0.25)
+        max_load = 0.25;
+    if (max_load > 0.9375)
+        max_load = 0.9375;
+
+    size_t used = M->size + M->tombstones;
+    M->max_load = max_load;
+    if (usable(M, M->capacity) <= M->size) {
+        // already over the new limit, grow until the entries fit under it again
+        rehash(M, capacity_for(M, M->capacity * 2, M->size + 1), NULL);
+        return;
+    }
+    M->growth_left = usable(M, M->capacity) > used ? usable(M, M->capacity) - used : 0;
+}
+
+uint64_t hash_map_hash_bytes(const void *data, size_t len) {
+    // FNV-1a, the mixing in `hash_of` makes up for its weak high bits
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < len; i++) {
+        h ^= bytes[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+uint64_t hash_map_hash_str(const void *key) {
+    const char *str = *(const char *const *)key;
+    return hash_map_hash_bytes(str, strlen(str));
+}
+
+bool hash_map_eq_str(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b) == 0;
+}
+
+// Hashes a key and mixes the result (the murmur3 finalizer), so both the 7 tag bits and the position bits are usable
+// even for identity hashes.
+static uint64_t hash_of(hashmap_t *M, const void *key) {
+    uint64_t h = M->hash ? M->hash(key) : hash_map_hash_bytes(key, M->key_size);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+static void set_ctrl(hashmap_t *M, size_t i, uint8_t tag) {
+    M->ctrl[i] = tag;
+    if (i < GROUP_WIDTH)
+        M->ctrl[M->capacity + i] = tag;
+}
+
+// Returns a bitmask of the tags in the group equal to `tag`, bit `k` standing for the `k`th slot of the group.
+static uint16_t group_match(const uint8_t *group, uint8_t tag) {
+#ifdef __SSE2__
+    __m128i tags = _mm_loadu_si128((const __m128i *)group);
+    return (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8((char)tag)));
+#else
+    uint16_t mask = 0;
+    for (int k = 0; k < GROUP_WIDTH; k++)
+        mask |= (uint16_t)(group[k] == tag) << k;
+    return mask;
+#endif
+}
+
+// Returns a bitmask of the empty or erased slots in the group, which are the tags with their high bit set.
+static uint16_t group_free(const uint8_t *group) {
+#ifdef __SSE2__
+    return (uint16_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+    uint16_t mask = 0;
+    for (int k = 0; k < GROUP_WIDTH; k++)
+        mask |= (uint16_t)(group[k] >> 7) << k;
+    return mask;
+#endif
+}
+
+// Returns the slot holding `key`, or the capacity if there is none. Groups are probed triangularly (1, 2, 3... groups
+// apart), which visits every group of a power-of-two table, until one with an empty slot ends the search.
+static size_t find(hashmap_t *M, const void *key, uint64_t h) {
+    size_t mask = M->capacity - 1;
+    size_t pos = (size_t)(h >> 7) & mask;
+    uint8_t tag = (uint8_t)(h & 0x7F);
+    hash_map_eq_t eq = M->eq;
+
+    for (size_t step = GROUP_WIDTH;; step += GROUP_WIDTH) {
+        const uint8_t *group = M->ctrl + pos;
+
+        for (uint16_t match = group_match(group, tag); match; match &= match - 1) {
+            size_t i = (pos + (size_t)__builtin_ctz(match)) & mask;
+            const uint8_t *slot = slot_at(M, i);
+            if (eq ? eq(slot, key) : memcmp(slot, key, M->key_size) == 0)
+                return i;
+        }
+
+        if (group_match(group, CTRL_EMPTY))
+            return M->capacity;
+        pos = (pos + step) & mask;
+    }
+}
+
+// Returns the first empty or erased slot along the probe sequence of `h`.
+static size_t find_free(hashmap_t *M, uint64_t h) {
+    size_t mask = M->capacity - 1;
+    size_t pos = (size_t)(h >> 7) & mask;
+
+    for (size_t step = GROUP_WIDTH;; step += GROUP_WIDTH) {
+        uint16_t free_slots = group_free(M->ctrl + pos);
+        if (free_slots)
+            return (pos + (size_t)__builtin_ctz(free_slots)) & mask;
+        pos = (pos + step) & mask;
+    }
+}
+
+static void allocate(hashmap_t *M, size_t capacity) {
+    M->ctrl = (uint8_t *)malloc(capacity + GROUP_WIDTH);
+    M->slots = (uint8_t *)malloc(capacity * M->slot_size);
+    assert(M->ctrl != NULL && M->slots != NULL && "failed to allocate hash map");
+
+    memset(M->ctrl, CTRL_EMPTY, capacity + GROUP_WIDTH);
+    M->capacity = capacity;
+    M->tombstones = 0;
+    M->growth_left = usable(M, capacity) > M->size ? usable(M, capacity) - M->size : 0;
+}
+
+// Moves every entry into a fresh table of `capacity` slots, dropping all tombstones. If `retired` is given the old slots
+// are handed back there for the caller to free, instead of being freed straight away.
+static void rehash(hashmap_t *M, size_t capacity, uint8_t **retired) {
+    uint8_t *old_ctrl = M->ctrl;
+    uint8_t *old_slots = M->slots;
+    size_t old_capacity = M->capacity;
+
+    allocate(M, capacity);
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (!is_full(old_ctrl[i]))
+            continue;
+
+        const uint8_t *slot = old_slots + i * M->slot_size;
+        uint64_t h = hash_of(M, slot);
+        size_t j = find_free(M, h);
+        set_ctrl(M, j, (uint8_t)(h & 0x7F));
+        memcpy(slot_at(M, j), slot, M->slot_size);
+    }
+
+    free(old_ctrl);
+    if (retired)
+        *retired = old_slots;
+    else
+        free(old_slots);
+}
+
+// Finds or adds the entry for `key` and returns its value, copying `value` in if given (over the old value of an
+// existing entry too). `key` and `value` may point into the map itself: if adding the entry rehashes the map, the old
+// slots they point into are kept around until both have been copied.
+static uint8_t *insert(hashmap_t *M, const void *key, const void *value, bool *inserted) {
+    uint64_t h = hash_of(M, key);
+
+    size_t i = find(M, key, h);
+    if (i != M->capacity) {
+        uint8_t *dst = slot_at(M, i) + M->value_offset;
+        if (value)
+            memmove(dst, value, M->value_size);
+        if (inserted)
+            *inserted = false;
+        return dst;
+    }
+
+    uint8_t *retired = NULL;
+    i = find_free(M, h);
+    if (M->growth_left == 0 && M->ctrl[i] == CTRL_EMPTY) {
+        const uint8_t *end = M->slots + M->capacity * M->slot_size;
+        bool aliased = ((const uint8_t *)key >= M->slots && (const uint8_t *)key < end) ||
+                       (value && (const uint8_t *)value >= M->slots && (const uint8_t *)value < end);
+
+        // a map mostly full of tombstones is cleaned up in place, otherwise it doubles (more than once if the max load
+        // was lowered since it last grew)
+        size_t cap = M->size + 1 <= usable(M, M->capacity) / 2 ? M->capacity
+                                                                 : capacity_for(M, M->capacity * 2, M->size + 1);
+        rehash(M, cap, aliased ? &retired : NULL);
+        i = find_free(M, h);
+    }
+
+    if (M->ctrl[i] == CTRL_DELETED)
+        M->tombstones--;
+    else
+        M->growth_left--;
+    set_ctrl(M, i, (uint8_t)(h & 0x7F));
+    M->size++;
+
+    uint8_t *slot = slot_at(M, i);
+    memcpy(slot, key, M->key_size);
+    if (value)
+        memcpy(slot + M->value_offset, value, M->value_size);
+    free(retired);
+    if (inserted)
+        *inserted = true;
+    return slot + M->value_offset;
+}
+
+// Returns how many slots of a table of `capacity` may be used under the max load.
+static size_t usable(hashmap_t *M, size_t capacity) { return (size_t)((double)capacity * M->max_load); }
+
+// Doubles `capacity` until `count` entries fit under the max load.
+static size_t capacity_for(hashmap_t *M, size_t capacity, size_t count) {
+    while (usable(M, capacity) < count)
+        capacity *= 2;
+    return capacity;
+}
@@ -0,0 +1,94 @@
+#include <sncl_intrusivelist.h>
+
+static void link_between(intrusive_list_t *L, intrusive_link_t *prev, intrusive_link_t *next, intrusive_link_t *link);
+
+void intrusive_list_init(intrusive_list_t *list) {
+    list->head.next = &list->head;
+    list->head.prev = &list->head;
+    list->size = 0;
+}
+
+void intrusive_link_init(intrusive_link_t *link) {
+    link->next = NULL;
+    link->prev = NULL;
+}
+
+bool intrusive_link_is_linked(const intrusive_link_t *link) { return link->next != NULL; }
+
+intrusive_link_t *intrusive_list_first(intrusive_list_t *list) {
+    return list->head.next == &list->head ? NULL : list->head.next;
+}
+
+intrusive_link_t *intrusive_list_last(intrusive_list_t *list) {
+    return list->head.prev == &list->head ? NULL : list->head.prev;
+}
+
+intrusive_link_t *intrusive_list_next(intrusive_list_t *list, intrusive_link_t *link) {
+    return link->next == &list->head ? NULL : link->next;
+}
+
+intrusive_link_t *intrusive_list_prev(intrusive_list_t *list, intrusive_link_t *link) {
+    return link->prev == &list->head ? NULL : link->prev;
+}
+
+bool intrusive_list_empty(const intrusive_list_t *list) { return list->size == 0; }
+
+size_t intrusive_list_size(const intrusive_list_t *list) { return list->size; }
+
+void intrusive_list_push_front(intrusive_list_t *list, intrusive_link_t *link) {
+    link_between(list, &list->head, list->head.next, link);
+}
+
+void intrusive_list_push_back(intrusive_list_t *list, intrusive_link_t *link) {
+    link_between(list, list->head.prev, &list->head, link);
+}
+
+void intrusive_list_insert_before(intrusive_list_t *list, intrusive_link_t *pos, intrusive_link_t *link) {
+    link_between(list, pos->prev, pos, link);
+}
+
+void intrusive_list_insert_after(intrusive_list_t *list, intrusive_link_t *pos, intrusive_link_t *link) {
+    link_between(list, pos, pos->next, link);
+}
+
+void intrusive_list_remove(intrusive_list_t *list, intrusive_link_t *link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = NULL;
+    link->prev = NULL;
+    list->size--;
+}
+
+intrusive_link_t *intrusive_list_pop_front(intrusive_list_t *list) {
+    intrusive_link_t *link = intrusive_list_first(list);
+    if (link)
+        intrusive_list_remove(list, link);
+    return link;
+}
+
+intrusive_link_t *intrusive_list_pop_back(intrusive_list_t *list) {
+    intrusive_link_t *link = intrusive_list_last(list);
+    if (link)
+        intrusive_list_remove(list, link);
+    return link;
+}
+
+void intrusive_list_clear(intrusive_list_t *list) {
+    intrusive_link_t *curr = list->head.next;
+    while (curr != &list->head) {
+        intrusive_link_t *next = curr->next;
+        curr->next = NULL;
+        curr->prev = NULL;
+        curr = next;
+    }
+
+    intrusive_list_init(list);
+}
+
+static void link_between(intrusive_list_t *L, intrusive_link_t *prev, intrusive_link_t *next, intrusive_link_t *link) {
+    link->prev = prev;
+    link->next = next;
+    prev->next = link;
+    next->prev = link;
+    L->size++;
+}
@@ -1,10 +1,34 @@
+// sysconf and pthreads are POSIX, which a strict C99 build hides otherwise
+#if !defined(_POSIX_C_SOURCE) && defined(__unix__)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <sncl_linkedlist.h>
 
+#include <assert.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <unistd.h>
+#define RANGE_THREADS
+#endif
+
 typedef struct SNCL_LLNode sncl_llnode_t;
+typedef struct SNCL_LLSlab sncl_llslab_t;
+
+// Node pool of a pooled list. Nodes are carved out of slabs in order, and freed nodes go on a free list that is drawn
+// from first. Slabs are only given back when the list is destroyed.
+typedef struct {
+    sncl_llslab_t *slabs;   // every slab, in the order they are carved from
+    sncl_llslab_t *current; // the slab nodes are being carved from
+    size_t carved;          // nodes carved from the current slab so far
+    sncl_llnode_t *free_list;
+    size_t slab_nodes;
+    size_t node_size;
+} sncl_llpool_t;
 
 typedef struct {
     sncl_llnode_t *first;
@@ -15,6 +39,20 @@ typedef struct {
 
     size_t size;
     size_t type_size;
+
+    sncl_llpool_t *pool; // `NULL` when every node is its own allocation
+
+    // the node last reached by a positional access, and its index
+    sncl_llnode_t *finger;
+    size_t finger_idx;
+
+    // every `stride`-th node, valid only while `index_valid` is set
+    sncl_llnode_t **index;
+    size_t index_count;
+    size_t index_capacity;
+    size_t stride; // 0 when the list has no index
+    bool index_valid;
+    size_t walked; // steps walked since the index went stale
 } linkedlist_t;
 
 struct SNCL_LLNode {
@@ -23,10 +61,28 @@ struct SNCL_LLNode {
     char data[];
 };
 
+struct SNCL_LLSlab {
+    sncl_llslab_t *next;
+    union {
+        char bytes[1];
+        void *align_ptr_;
+        long double align_ld_;
+        long long align_ll_;
+    } nodes[]; // `slab_nodes` nodes of `node_size` bytes each
+};
+
 #define node(v) ((sncl_llnode_t *)(v))
 #define xor_ptr(a, b) (void *)((uintptr_t)(a) ^ (uintptr_t)(b))
 
 static sncl_llnode_t *new_node(linkedlist_t *L, void *val);
+static void free_node(linkedlist_t *L, sncl_llnode_t *n);
+static sncl_llnode_t *locate(linkedlist_t *L, size_t idx);
+static sncl_llnode_t *peek(const linkedlist_t *L, size_t idx);
+static void index_append(linkedlist_t *L, sncl_llnode_t *n);
+static void shift_after(linkedlist_t *L, size_t pos, bool added);
+static void unlink_node(linkedlist_t *L, sncl_llnode_t *n);
+static bool move_nodes(linkedlist_t *dst, sncl_llnode_t *at, linkedlist_t *src, sncl_llnode_t *first,
+                       sncl_llnode_t *last, size_t count);
 
 linkedlist_t *retrieve_from_data(void *data_ptr) { return (linkedlist_t *)(data_ptr); }
 
@@ -40,15 +96,78 @@ void *linked_list__create(size_t type_size) {
     ll->it__ = NULL;
     ll->size = 0;
     ll->type_size = type_size;
+    ll->pool = NULL;
+    ll->finger = NULL;
+    ll->finger_idx = 0;
+    ll->index = NULL;
+    ll->index_count = 0;
+    ll->index_capacity = 0;
+    ll->stride = 0;
+    ll->index_valid = true;
+    ll->walked = 0;
+
+    return (void *)ll;
+}
+
+void *linked_list__create_pooled(size_t type_size, size_t slab_nodes) {
+    linkedlist_t *ll = (linkedlist_t *)linked_list__create(type_size);
+    if (!ll)
+        return NULL;
+
+    ll->pool = (sncl_llpool_t *)malloc(sizeof(sncl_llpool_t));
+    if (!ll->pool) {
+        free(ll);
+        return NULL;
+    }
+
+    // nodes are padded so every node in a slab stays aligned like the slab itself
+    size_t align = sizeof(((sncl_llslab_t *)0)->nodes[0]);
+    ll->pool->slabs = NULL;
+    ll->pool->current = NULL;
+    ll->pool->carved = 0;
+    ll->pool->free_list = NULL;
+    ll->pool->slab_nodes = slab_nodes ? slab_nodes : 1;
+    ll->pool->node_size = (sizeof(sncl_llnode_t) + type_size + align - 1) / align * align;
 
     return (void *)ll;
 }
 
 void linked_list__destroy(void *ll) {
+    linkedlist_t *L = ll;
     linked_list_clear(ll);
+
+    if (L->pool) {
+        sncl_llslab_t *slab = L->pool->slabs;
+        while (slab) {
+            sncl_llslab_t *next = slab->next;
+            free(slab);
+            slab = next;
+        }
+        free(L->pool);
+    }
+    free(L->index);
     free(ll);
 }
 
+bool linked_list_is_pooled(void *ll) {
+    linkedlist_t *L = retrieve_from_data(ll);
+    return L->pool != NULL;
+}
+
+void linked_list_set_index_stride(void *ll, size_t stride) {
+    linkedlist_t *L = retrieve_from_data(ll);
+    L->stride = stride;
+    L->index_count = 0;
+    L->index_valid = false;
+    L->walked = 0;
+
+    if (!stride) {
+        free(L->index);
+        L->index = NULL;
+        L->index_capacity = 0;
+    }
+}
+
 void linked_list__start(void *ll) {
     linkedlist_t *L = retrieve_from_data(ll);
     L->it__ = (iterator_t)L->first;
@@ -85,21 +204,8 @@ void linked_list_it_remove(void *ll) {
     else
         to_remove = L->last;
 
-    if (!to_remove)
-        return;
-
-    if (to_remove->prev)
-        to_remove->prev->next = to_remove->next;
-    else
-        L->first = to_remove->next;
-
-    if (to_remove->next)
-        to_remove->next->prev = to_remove->prev;
-    else
-        L->last = to_remove->prev;
-
-    free(to_remove);
-    L->size--;
+    if (to_remove)
+        unlink_node(L, to_remove);
 }
 
 iterator_t linked_list_it_next(iterator_t current) { return (iterator_t)(node(current)->next); }
@@ -111,6 +217,146 @@ iterator_t linked_list_begin(void *ll) {
 
 iterator_t linked_list_end(__attribute__((unused)) void *ll) { return NULL; }
 
+linked_list_iter_t linked_list_iter_begin(void *ll) {
+    linkedlist_t *L = retrieve_from_data(ll);
+    linked_list_iter_t it = { ll, L->first, true };
+    return it;
+}
+
+linked_list_iter_t linked_list_iter_rbegin(void *ll) {
+    linkedlist_t *L = retrieve_from_data(ll);
+    linked_list_iter_t it = { ll, L->last, false };
+    return it;
+}
+
+void *linked_list_iter_get(linked_list_iter_t *it) { return it->node ? node(it->node)->data : NULL; }
+
+void linked_list_iter_next(linked_list_iter_t *it) {
+    if (it->node)
+        it->node = it->forward ? node(it->node)->next : node(it->node)->prev;
+}
+
+void linked_list_iter_prev(linked_list_iter_t *it) {
+    if (it->node)
+        it->node = it->forward ? node(it->node)->prev : node(it->node)->next;
+}
+
+void linked_list_iter_remove(linked_list_iter_t *it) {
+    sncl_llnode_t *n = it->node;
+    if (!n)
+        return;
+
+    it->node = it->forward ? n->next : n->prev;
+    unlink_node(it->list, n);
+}
+
+void linked_list_iter_insert_before(linked_list_iter_t *it, void *val) {
+    linkedlist_t *L = it->list;
+    sncl_llnode_t *at = it->node;
+    if (!at)
+        return linked_list__push_back(L, val);
+    if (at == L->first)
+        return linked_list__push_front(L, val);
+
+    sncl_llnode_t *n = new_node(L, val);
+    if (!n)
+        return;
+
+    n->prev = at->prev;
+    n->next = at;
+    at->prev->next = n;
+    at->prev = n;
+    L->size++;
+
+    // the position is unknown here, so neither can be kept in step
+    L->finger = NULL;
+    L->index_valid = false;
+}
+
+#ifdef RANGE_THREADS
+// lists shorter than this per thread are walked with fewer threads, as starting one costs more than the walk
+#define RANGE_PARALLEL_MIN 4096
+#define RANGE_MAX_THREADS 64
+
+typedef struct {
+    sncl_llnode_t *start;
+    size_t count;
+    void (*fn)(void *elem, void *ctx);
+    void *ctx;
+} range_worker_t;
+
+static void *range_worker(void *arg) {
+    range_worker_t *w = arg;
+    sncl_llnode_t *n = w->start;
+    for (size_t i = 0; i < w->count; i++, n = n->next)
+        w->fn(n->data, w->ctx);
+    return NULL;
+}
+#endif // RANGE_THREADS
+
+void linked_list_for_each_range(void *ll, size_t begin, size_t end, void (*fn)(void *elem, void *ctx), void *ctx,
+                                size_t threads) {
+    linkedlist_t *L = retrieve_from_data(ll);
+    if (end > L->size)
+        end = L->size;
+    if (begin >= end)
+        return;
+
+    size_t n = end - begin;
+
+#ifdef RANGE_THREADS
+    if (threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+
+    size_t t = threads < RANGE_MAX_THREADS ? threads : RANGE_MAX_THREADS;
+    if (t > n / RANGE_PARALLEL_MIN)
+        t = n / RANGE_PARALLEL_MIN;
+
+    if (t > 1) {
+        pthread_t handles[RANGE_MAX_THREADS];
+        bool started[RANGE_MAX_THREADS];
+        range_worker_t workers[RANGE_MAX_THREADS];
+
+        // each chunk's first node is found by walking on from the previous one, or straight from the index when it is
+        // current
+        size_t chunk = n / t, extra = n % t, at = begin;
+        sncl_llnode_t *start = peek(L, begin);
+        for (size_t i = 0; i < t; i++) {
+            workers[i] = (range_worker_t){ start, chunk + (i < extra), fn, ctx };
+            at += workers[i].count;
+            if (i + 1 == t)
+                break;
+            if (L->stride && L->index_valid) {
+                start = peek(L, at);
+            } else {
+                for (size_t j = 0; j < workers[i].count; j++)
+                    start = start->next;
+            }
+        }
+
+        // a chunk whose thread can't be started is walked on the calling thread instead
+        for (size_t i = 1; i < t; i++)
+            started[i] = pthread_create(&handles[i], NULL, range_worker, &workers[i]) == 0;
+        range_worker(&workers[0]);
+        for (size_t i = 1; i < t; i++) {
+            if (started[i])
+                pthread_join(handles[i], NULL);
+            else
+                range_worker(&workers[i]);
+        }
+        return;
+    }
+#else
+    (void)threads;
+#endif
+
+    sncl_llnode_t *curr = peek(L, begin);
+    for (size_t i = 0; i < n; i++, curr = curr->next)
+        fn(curr->data, ctx);
+}
+
 void *linked_list__front(void *ll) {
     linkedlist_t *L = retrieve_from_data(ll);
     return (void *)(L->first->data);
@@ -123,20 +369,10 @@ void *linked_list__back(void *ll) {
 
 void *linked_list__get(void *ll, size_t offset) {
     linkedlist_t *L = retrieve_from_data(ll);
-    if (offset == 0)
-        return linked_list__front(ll);
-    if (offset == L->size - 1)
-        return linked_list__back(ll);
     if (offset >= L->size)
         return NULL;
 
-    sncl_llnode_t *curr = L->first;
-    while (offset > 0) {
-        curr = curr->next;
-        offset--;
-    }
-
-    return (void *)(curr->data);
+    return (void *)(locate(L, offset)->data);
 }
 
 bool linked_list_empty(void *ll) {
@@ -151,7 +387,14 @@ size_t linked_list_size(void *ll) {
 
 void linked_list_clear(void *ll) {
     linkedlist_t *L = ll;
-    sncl_llnode_t *curr = L->first;
+    sncl_llnode_t *curr = L->pool ? NULL : L->first;
+
+    // a pooled list hands every node back at once by starting to carve from its first slab again
+    if (L->pool) {
+        L->pool->current = L->pool->slabs;
+        L->pool->carved = 0;
+        L->pool->free_list = NULL;
+    }
 
     while (curr) {
         sncl_llnode_t *next = curr->next;
@@ -161,6 +404,10 @@ void linked_list_clear(void *ll) {
 
     L->first = L->last = NULL;
     L->size = 0;
+    L->finger = NULL;
+    L->index_count = 0;
+    L->index_valid = true;
+    L->walked = 0;
 }
 
 void linked_list__add(void *ll, size_t pos, void *val) {
@@ -172,11 +419,11 @@ void linked_list__add(void *ll, size_t pos, void *val) {
     if (pos > L->size)
         return;
 
-    sncl_llnode_t *curr = L->first;
-    for (size_t i = 0; i < pos; i++)
-        curr = curr->next;
-
+    sncl_llnode_t *curr = locate(L, pos);
     sncl_llnode_t *n = new_node(L, val);
+    if (!n)
+        return;
+
     n->prev = curr->prev;
     n->next = curr;
 
@@ -184,6 +431,9 @@ void linked_list__add(void *ll, size_t pos, void *val) {
     curr->prev = n;
 
     L->size++;
+    shift_after(L, pos, true);
+    L->finger = n;
+    L->finger_idx = pos;
 }
 
 void linked_list__push_front(void *ll, void *val) {
@@ -200,6 +450,7 @@ void linked_list__push_front(void *ll, void *val) {
 
     L->first = n;
     L->size++;
+    shift_after(L, 0, true);
 }
 
 void linked_list__push_back(void *ll, void *val) {
@@ -216,6 +467,8 @@ void linked_list__push_back(void *ll, void *val) {
 
     L->last = n;
     L->size++;
+    if (L->stride && L->index_valid && (L->size - 1) % L->stride == 0)
+        index_append(L, n);
 }
 
 void linked_list__remove(void *ll, size_t pos) {
@@ -227,14 +480,16 @@ void linked_list__remove(void *ll, size_t pos) {
     if (pos == L->size - 1)
         return linked_list__pop_back(ll);
 
-    sncl_llnode_t *curr = L->first;
-    for (size_t i = 0; i < pos; i++)
-        curr = curr->next;
-
+    sncl_llnode_t *curr = locate(L, pos);
     curr->prev->next = curr->next;
     curr->next->prev = curr->prev;
-    free(curr);
+
+    // the node after takes over both the index and the finger
+    L->finger = curr->next;
+    L->finger_idx = pos;
+    free_node(L, curr);
     L->size--;
+    shift_after(L, pos, false);
 }
 
 void linked_list__pop_front(void *ll) {
@@ -250,8 +505,11 @@ void linked_list__pop_front(void *ll) {
     else
         L->last = NULL;
 
-    free(n);
+    if (L->finger == n)
+        L->finger = NULL;
+    free_node(L, n);
     L->size--;
+    shift_after(L, 0, false);
 }
 
 void linked_list__pop_back(void *ll) {
@@ -267,12 +525,87 @@ void linked_list__pop_back(void *ll) {
     else
         L->first = NULL;
 
-    free(n);
+    if (L->finger == n)
+        L->finger = NULL;
+    // removing the tail leaves every other index entry where it was
+    if (L->index_valid && L->index_count && L->index[L->index_count - 1] == n)
+        L->index_count--;
+    free_node(L, n);
     L->size--;
 }
 
+void linked_list_splice(void *dst, size_t pos, void *src) {
+    linkedlist_t *D = retrieve_from_data(dst), *S = retrieve_from_data(src);
+    if (pos > D->size || D == S || !S->size)
+        return;
+
+    sncl_llnode_t *at = pos == D->size ? NULL : locate(D, pos);
+    move_nodes(D, at, S, S->first, S->last, S->size);
+}
+
+void linked_list_concat(void *dst, void *src) {
+    linkedlist_t *D = retrieve_from_data(dst);
+    linked_list_splice(dst, D->size, src);
+}
+
+void *linked_list__split_at(void *ll, size_t pos) {
+    linkedlist_t *L = retrieve_from_data(ll);
+    if (pos > L->size)
+        return NULL;
+
+    linkedlist_t *tail = L->pool ? linked_list__create_pooled(L->type_size, L->pool->slab_nodes)
+                                 : linked_list__create(L->type_size);
+    if (!tail)
+        return NULL;
+
+    if (pos < L->size && !move_nodes(tail, NULL, L, locate(L, pos), L->last, L->size - pos)) {
+        linked_list__destroy(tail);
+        return NULL;
+    }
+    return (void *)tail;
+}
+
+void linked_list_move_range(void *dst, size_t pos, void *src, size_t begin, size_t end) {
+    linkedlist_t *D = retrieve_from_data(dst), *S = retrieve_from_data(src);
+    if (end > S->size)
+        end = S->size;
+    if (pos > D->size || D == S || begin >= end)
+        return;
+
+    sncl_llnode_t *at = pos == D->size ? NULL : locate(D, pos);
+    sncl_llnode_t *first = locate(S, begin);
+    sncl_llnode_t *last = locate(S, end - 1);
+    move_nodes(D, at, S, first, last, end - begin);
+}
+
 static sncl_llnode_t *new_node(linkedlist_t *L, void *val) {
-    sncl_llnode_t *n = malloc(sizeof(sncl_llnode_t) + L->type_size);
+    sncl_llnode_t *n;
+    sncl_llpool_t *P = L->pool;
+
+    if (!P) {
+        n = malloc(sizeof(sncl_llnode_t) + L->type_size);
+    } else if (P->free_list) {
+        n = P->free_list;
+        P->free_list = n->next;
+    } else {
+        if (!P->current || P->carved == P->slab_nodes) {
+            // move on to the next slab, only allocating one when every slab has been carved up
+            sncl_llslab_t *next = P->current ? P->current->next : P->slabs;
+            if (!next) {
+                next = (sncl_llslab_t *)malloc(sizeof(sncl_llslab_t) + P->slab_nodes * P->node_size);
+                if (!next)
+                    return NULL;
+                next->next = NULL;
+                if (P->current)
+                    P->current->next = next;
+                else
+                    P->slabs = next;
+            }
+            P->current = next;
+            P->carved = 0;
+        }
+        n = (sncl_llnode_t *)((char *)P->current->nodes + P->carved++ * P->node_size);
+    }
     if (!n)
         return NULL;
 
@@ -281,3 +614,218 @@ static sncl_llnode_t *new_node(linkedlist_t *L, void *val) {
     n->prev = NULL;
     return n;
 }
+
+static void free_node(linkedlist_t *L, sncl_llnode_t *n) {
+    if (!L->pool)
+        return free(n);
+
+    n->next = L->pool->free_list;
+    L->pool->free_list = n;
+}
+
+// unlinks and frees `n`, for removals whose position is unknown
+static void unlink_node(linkedlist_t *L, sncl_llnode_t *n) {
+    if (n->prev)
+        n->prev->next = n->next;
+    else
+        L->first = n->next;
+
+    if (n->next)
+        n->next->prev = n->prev;
+    else
+        L->last = n->prev;
+
+    // without the position, neither the finger nor the index can be kept in step
+    L->finger = NULL;
+    L->index_valid = false;
+
+    free_node(L, n);
+    L->size--;
+}
+
+// moves the `count` nodes from `first` through `last` out of `src` and in front of `at` in `dst`, or at its back when `at`
+// is `NULL`. Nodes are relinked as they are unless either list is pooled, as a pooled node has to go back to the pool
+// it came from, in which case they are copied into new nodes of `dst` instead. Every copy is made before anything is
+// taken out of `src`, so if one can't be allocated both lists are left as they were and `false` is returned.
+static bool move_nodes(linkedlist_t *dst, sncl_llnode_t *at, linkedlist_t *src, sncl_llnode_t *first,
+                       sncl_llnode_t *last, size_t count) {
+    assert(dst->type_size == src->type_size && "cannot move elements between lists of different types");
+
+    sncl_llnode_t *copy_first = NULL, *copy_last = NULL;
+    if (dst->pool || src->pool) {
+        sncl_llnode_t *curr = first;
+        for (size_t i = 0; i < count; i++, curr = curr->next) {
+            sncl_llnode_t *copy = new_node(dst, curr->data);
+            if (!copy) {
+                while (copy_first) {
+                    sncl_llnode_t *next = copy_first->next;
+                    free_node(dst, copy_first);
+                    copy_first = next;
+                }
+                return false;
+            }
+
+            copy->prev = copy_last;
+            copy->next = NULL;
+            if (copy_last)
+                copy_last->next = copy;
+            else
+                copy_first = copy;
+            copy_last = copy;
+        }
+    }
+
+    sncl_llnode_t *before = first->prev, *after = last->next;
+    if (before)
+        before->next = after;
+    else
+        src->first = after;
+    if (after)
+        after->prev = before;
+    else
+        src->last = before;
+
+    src->size -= count;
+    src->finger = NULL;
+    src->index_valid = false;
+
+    if (copy_first) {
+        for (sncl_llnode_t *curr = first, *next; curr != after; curr = next) {
+            next = curr->next;
+            free_node(src, curr);
+        }
+        first = copy_first;
+        last = copy_last;
+    }
+
+    first->prev = at ? at->prev : dst->last;
+    last->next = at;
+    if (first->prev)
+        first->prev->next = first;
+    else
+        dst->first = first;
+    if (at)
+        at->prev = last;
+    else
+        dst->last = last;
+
+    dst->size += count;
+    dst->finger = NULL;
+    dst->index_valid = false;
+    return true;
+}
+
+// walks to the node at `idx`, starting from whichever of the head, the tail, the finger and the index is closest.
+// `idx` must be below the size.
+static sncl_llnode_t *locate(linkedlist_t *L, size_t idx) {
+    sncl_llnode_t *curr = L->first;
+    size_t at = 0;
+
+    if (L->size - 1 - idx < idx) {
+        curr = L->last;
+        at = L->size - 1;
+    }
+    if (L->finger) {
+        size_t dist = idx > L->finger_idx ? idx - L->finger_idx : L->finger_idx - idx;
+        size_t best = idx > at ? idx - at : at - idx;
+        if (dist < best) {
+            curr = L->finger;
+            at = L->finger_idx;
+        }
+    }
+
+    if (L->stride) {
+        size_t best = idx > at ? idx - at : at - idx;
+
+        // only rebuild a stale index once walking has cost about as much as the rebuild does, so lists that keep
+        // changing in the middle never pay for it on every access
+        if (!L->index_valid && best > L->stride && L->walked + best >= L->size) {
+            L->index_count = 0;
+            L->index_valid = true;
+            L->walked = 0;
+            size_t i = 0;
+            for (sncl_llnode_t *n = L->first; n && L->index_valid; n = n->next, i++)
+                if (i % L->stride == 0)
+                    index_append(L, n);
+        }
+
+        if (L->index_valid && L->index_count) {
+            size_t slot = (idx + L->stride / 2) / L->stride;
+            if (slot >= L->index_count)
+                slot = L->index_count - 1;
+            size_t dist = idx > slot * L->stride ? idx - slot * L->stride : slot * L->stride - idx;
+            if (dist < best) {
+                curr = L->index[slot];
+                at = slot * L->stride;
+            }
+        }
+    }
+
+    if (L->stride && !L->index_valid)
+        L->walked += idx > at ? idx - at : at - idx;
+    for (; at < idx; at++)
+        curr = curr->next;
+    for (; at > idx; at--)
+        curr = curr->prev;
+
+    L->finger = curr;
+    L->finger_idx = idx;
+    return curr;
+}
+
+// Finds the node at `idx` like `locate` does but without touching the finger or the index, walking from the nearest end
+// or from a current index entry, so any number of threads may call it at once.
+static sncl_llnode_t *peek(const linkedlist_t *L, size_t idx) {
+    sncl_llnode_t *curr = L->first;
+    size_t at = 0;
+
+    if (L->size - 1 - idx < idx) {
+        curr = L->last;
+        at = L->size - 1;
+    }
+    if (L->stride && L->index_valid && L->index_count) {
+        size_t slot = (idx + L->stride / 2) / L->stride;
+        if (slot >= L->index_count)
+            slot = L->index_count - 1;
+        size_t dist = idx > slot * L->stride ? idx - slot * L->stride : slot * L->stride - idx;
+        if (dist < (idx > at ? idx - at : at - idx)) {
+            curr = L->index[slot];
+            at = slot * L->stride;
+        }
+    }
+
+    for (; at < idx; at++)
+        curr = curr->next;
+    for (; at > idx; at--)
+        curr = curr->prev;
+    return curr;
+}
+
+// appends `n` to the index, marking the index stale if it cannot grow
+static void index_append(linkedlist_t *L, sncl_llnode_t *n) {
+    if (L->index_count == L->index_capacity) {
+        size_t capacity = L->index_capacity ? L->index_capacity * 2 : 16;
+        sncl_llnode_t **index = realloc(L->index, capacity * sizeof(sncl_llnode_t *));
+        if (!index) {
+            L->index_valid = false;
+            return;
+        }
+        L->index = index;
+        L->index_capacity = capacity;
+    }
+    L->index[L->index_count++] = n;
+}
+
+// keeps the finger and index in step with a node added or removed at `pos`, other than at the tail
+static void shift_after(linkedlist_t *L, size_t pos, bool added) {
+    if (L->finger && added && L->finger_idx >= pos)
+        L->finger_idx++;
+    else if (L->finger && !added && L->finger_idx > pos)
+        L->finger_idx--;
+
+    // every node after `pos` moved, so the index no longer lines up
+    if (L->stride && L->index_valid) {
+        L->index_valid = false;
+        L->walked = 0;
+    }
+}
@@ -0,0 +1,388 @@
+// futexes go through syscall(), which is hidden without _GNU_SOURCE, and the rest is POSIX, which a strict C99 build
+// hides otherwise
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#if !defined(_POSIX_C_SOURCE) && defined(__unix__)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <sncl_mpmcqueue.h>
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define USE_FUTEX
+#endif
+
+typedef struct SNCL_MQNode sncl_mqnode_t;
+
+struct SNCL_MQNode {
+    sncl_mqnode_t *next;
+    union {
+        char bytes[1];
+        void *align_ptr_;
+        long double align_ld_;
+        long long align_ll_;
+    } data[];
+};
+
+#define CACHE_LINE 64
+
+// nodes a handle keeps cached before handing a batch of them to the shared pool
+#define CACHE_MAX 256
+#define CACHE_BATCH 128
+// retired nodes on top of the hazard pointer count that trigger a scan
+#define RETIRE_SLACK 64
+
+struct SNCL_MQHandle {
+    // read by every scanning thread, so they get the first cache line to themselves
+    sncl_mqnode_t *hazards[2];
+    int in_use;
+    char pad_[CACHE_LINE - 2 * sizeof(void *) - sizeof(int)];
+
+    sncl_mqnode_t **retired; // unlinked nodes that may still be read through another thread's hazard pointer
+    size_t retired_count;
+    sncl_mqnode_t **scratch; // hazard pointers gathered while scanning
+
+    sncl_mqnode_t *cache; // free nodes, chained through `next`
+    size_t cache_count;
+    char pad_end_[CACHE_LINE - 5 * sizeof(void *)];
+};
+
+typedef struct {
+    // producers and consumers each hammer their own end, so the two live on different cache lines
+    sncl_mqnode_t *head;
+    char pad_head_[CACHE_LINE - sizeof(void *)];
+    sncl_mqnode_t *tail;
+    char pad_tail_[CACHE_LINE - sizeof(void *)];
+
+    // bumped on every push, the futex word for blocked pops
+    uint32_t seq;
+    uint32_t waiters;
+    char pad_seq_[CACHE_LINE - 2 * sizeof(uint32_t)];
+
+    pthread_mutex_t pool_lock;
+    sncl_mqnode_t *pool; // free nodes shared between handles, chained through `next`
+    size_t pool_count;
+
+    mpmc_queue_handle_t *handles;
+    size_t max_threads;
+    size_t retire_limit;
+    size_t type_size;
+    size_t node_size;
+} mpmcqueue_t;
+
+#define load(p) __atomic_load_n(p, __ATOMIC_SEQ_CST)
+#define store(p, v) __atomic_store_n(p, v, __ATOMIC_SEQ_CST)
+#define cas(p, expected, desired)                                                                                      \
+    __atomic_compare_exchange_n(p, expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+
+static sncl_mqnode_t *new_node(mpmcqueue_t *Q, mpmc_queue_handle_t *h);
+static void cache_node(mpmcqueue_t *Q, mpmc_queue_handle_t *h, sncl_mqnode_t *n);
+static void retire(mpmcqueue_t *Q, mpmc_queue_handle_t *h, sncl_mqnode_t *n);
+static void free_chain(sncl_mqnode_t *n);
+
+void *mpmc_queue__create(size_t type_size, size_t max_threads) {
+    mpmcqueue_t *Q;
+    if (posix_memalign((void **)&Q, CACHE_LINE, sizeof(mpmcqueue_t)) != 0)
+        return NULL;
+    memset(Q, 0, sizeof(mpmcqueue_t));
+
+    Q->max_threads = max_threads ? max_threads : 1;
+    Q->retire_limit = 2 * Q->max_threads + RETIRE_SLACK;
+    Q->type_size = type_size;
+    Q->node_size = sizeof(sncl_mqnode_t) + type_size;
+    pthread_mutex_init(&Q->pool_lock, NULL);
+
+    if (posix_memalign((void **)&Q->handles, CACHE_LINE, Q->max_threads * sizeof(mpmc_queue_handle_t)) != 0) {
+        free(Q);
+        return NULL;
+    }
+    memset(Q->handles, 0, Q->max_threads * sizeof(mpmc_queue_handle_t));
+
+    for (size_t i = 0; i < Q->max_threads; i++) {
+        Q->handles[i].retired = (sncl_mqnode_t **)malloc(Q->retire_limit * sizeof(sncl_mqnode_t *));
+        Q->handles[i].scratch = (sncl_mqnode_t **)malloc(2 * Q->max_threads * sizeof(sncl_mqnode_t *));
+        assert(Q->handles[i].retired && Q->handles[i].scratch && "failed to allocate queue handles");
+    }
+
+    // the queue always starts with a dummy node, whose value is never read
+    Q->head = Q->tail = new_node(Q, &Q->handles[0]);
+    Q->head->next = NULL;
+
+    return (void *)Q;
+}
+
+void mpmc_queue__destroy(void *q) {
+    mpmcqueue_t *Q = q;
+
+    free_chain(Q->head);
+    free_chain(Q->pool);
+    for (size_t i = 0; i < Q->max_threads; i++) {
+        mpmc_queue_handle_t *h = &Q->handles[i];
+        for (size_t j = 0; j < h->retired_count; j++)
+            free(h->retired[j]);
+        free_chain(h->cache);
+        free(h->retired);
+        free(h->scratch);
+    }
+
+    pthread_mutex_destroy(&Q->pool_lock);
+    free(Q->handles);
+    free(Q);
+}
+
+mpmc_queue_handle_t *mpmc_queue_attach(void *q) {
+    mpmcqueue_t *Q = q;
+    for (size_t i = 0; i < Q->max_threads; i++) {
+        int expected = 0;
+        if (cas(&Q->handles[i].in_use, &expected, 1))
+            return &Q->handles[i];
+    }
+    return NULL;
+}
+
+void mpmc_queue_detach(__attribute__((unused)) void *q, mpmc_queue_handle_t *h) {
+    store(&h->hazards[0], NULL);
+    store(&h->hazards[1], NULL);
+    store(&h->in_use, 0);
+}
+
+void mpmc_queue__push(void *q, mpmc_queue_handle_t *h, const void *val) {
+    mpmcqueue_t *Q = q;
+    sncl_mqnode_t *n = new_node(Q, h);
+    memcpy(n->data, val, Q->type_size);
+    n->next = NULL;
+
+    for (;;) {
+        sncl_mqnode_t *tail = load(&Q->tail);
+        store(&h->hazards[0], tail);
+        if (tail != load(&Q->tail))
+            continue;
+
+        sncl_mqnode_t *next = load(&tail->next);
+        if (tail != load(&Q->tail))
+            continue;
+
+        // another producer linked its node but has not swung the tail yet, help it along
+        if (next) {
+            cas(&Q->tail, &tail, next);
+            continue;
+        }
+
+        sncl_mqnode_t *expected = NULL;
+        if (cas(&tail->next, &expected, n)) {
+            cas(&Q->tail, &tail, n);
+            break;
+        }
+    }
+    store(&h->hazards[0], NULL);
+
+    __atomic_fetch_add(&Q->seq, 1, __ATOMIC_SEQ_CST);
+#ifdef USE_FUTEX
+    if (load(&Q->waiters))
+        syscall(SYS_futex, &Q->seq, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#endif
+}
+
+bool mpmc_queue__pop(void *q, mpmc_queue_handle_t *h, void *out) {
+    mpmcqueue_t *Q = q;
+    sncl_mqnode_t *head, *next;
+
+    for (;;) {
+        head = load(&Q->head);
+        store(&h->hazards[0], head);
+        if (head != load(&Q->head))
+            continue;
+
+        sncl_mqnode_t *tail = load(&Q->tail);
+        next = load(&head->next);
+        store(&h->hazards[1], next);
+        if (head != load(&Q->head))
+            continue;
+
+        if (!next) {
+            store(&h->hazards[0], NULL);
+            return false;
+        }
+
+        // the tail lags behind a node that is already linked, help it along before moving the head past it
+        if (head == tail) {
+            cas(&Q->tail, &tail, next);
+            continue;
+        }
+
+        if (cas(&Q->head, &head, next))
+            break;
+    }
+
+    // `next` is the new dummy, so `out` is only written once the swing has been won. The hazard pointer on it keeps it
+    // from being recycled even if another consumer pops past it meanwhile.
+    memcpy(out, next->data, Q->type_size);
+    store(&h->hazards[0], NULL);
+    store(&h->hazards[1], NULL);
+    retire(Q, h, head);
+    return true;
+}
+
+bool mpmc_queue__pop_wait(void *q, mpmc_queue_handle_t *h, void *out, long timeout_ms) {
+    mpmcqueue_t *Q = q;
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    if (timeout_ms >= 0) {
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    for (;;) {
+        // a push after reading `seq` changes it, so the wait below cannot miss it
+        __atomic_fetch_add(&Q->waiters, 1, __ATOMIC_SEQ_CST);
+        uint32_t seq = load(&Q->seq);
+        bool popped = mpmc_queue__pop(q, h, out);
+        if (popped) {
+            __atomic_fetch_sub(&Q->waiters, 1, __ATOMIC_SEQ_CST);
+            return true;
+        }
+
+        struct timespec now, left = { 0, 0 };
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (timeout_ms >= 0) {
+            left.tv_sec = deadline.tv_sec - now.tv_sec;
+            left.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+            if (left.tv_nsec < 0) {
+                left.tv_sec--;
+                left.tv_nsec += 1000000000L;
+            }
+            if (left.tv_sec < 0) {
+                __atomic_fetch_sub(&Q->waiters, 1, __ATOMIC_SEQ_CST);
+                return false;
+            }
+        }
+
+#ifdef USE_FUTEX
+        syscall(SYS_futex, &Q->seq, FUTEX_WAIT_PRIVATE, seq, timeout_ms >= 0 ? &left : NULL, NULL, 0);
+#else
+        // no futexes, so poll every 100us up to the deadline
+        (void)seq;
+        struct timespec nap = { 0, 100000L };
+        if (timeout_ms >= 0 && left.tv_sec == 0 && left.tv_nsec < nap.tv_nsec)
+            nap = left;
+        nanosleep(&nap, NULL);
+#endif
+        __atomic_fetch_sub(&Q->waiters, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+bool mpmc_queue_empty(void *q, mpmc_queue_handle_t *h) {
+    mpmcqueue_t *Q = q;
+    sncl_mqnode_t *head;
+
+    do {
+        head = load(&Q->head);
+        store(&h->hazards[0], head);
+    } while (head != load(&Q->head));
+
+    bool empty = load(&head->next) == NULL;
+    store(&h->hazards[0], NULL);
+    return empty;
+}
+
+static sncl_mqnode_t *new_node(mpmcqueue_t *Q, mpmc_queue_handle_t *h) {
+    if (!h->cache && __atomic_load_n(&Q->pool_count, __ATOMIC_RELAXED)) {
+        // refill from the shared pool a batch at a time
+        pthread_mutex_lock(&Q->pool_lock);
+        for (size_t i = 0; i < CACHE_BATCH && Q->pool; i++) {
+            sncl_mqnode_t *n = Q->pool;
+            Q->pool = n->next;
+            n->next = h->cache;
+            h->cache = n;
+            h->cache_count++;
+        }
+        __atomic_store_n(&Q->pool_count, Q->pool_count - h->cache_count, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&Q->pool_lock);
+    }
+
+    sncl_mqnode_t *n = h->cache;
+    if (n) {
+        h->cache = n->next;
+        h->cache_count--;
+        return n;
+    }
+
+    n = (sncl_mqnode_t *)malloc(Q->node_size);
+    assert(n != NULL && "failed to allocate a queue node");
+    return n;
+}
+
+static void cache_node(mpmcqueue_t *Q, mpmc_queue_handle_t *h, sncl_mqnode_t *n) {
+    n->next = h->cache;
+    h->cache = n;
+    if (++h->cache_count < CACHE_MAX)
+        return;
+
+    // consumers collect every node producers allocate, so overflowing caches flow back through the shared pool
+    sncl_mqnode_t *first = h->cache, *last = first;
+    for (size_t i = 1; i < CACHE_BATCH; i++)
+        last = last->next;
+    h->cache = last->next;
+    h->cache_count -= CACHE_BATCH;
+
+    pthread_mutex_lock(&Q->pool_lock);
+    last->next = Q->pool;
+    Q->pool = first;
+    __atomic_store_n(&Q->pool_count, Q->pool_count + CACHE_BATCH, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&Q->pool_lock);
+}
+
+static int compare_ptrs(const void *a, const void *b) {
+    uintptr_t x = (uintptr_t)*(sncl_mqnode_t *const *)a, y = (uintptr_t)*(sncl_mqnode_t *const *)b;
+    return (x > y) - (x < y);
+}
+
+static void retire(mpmcqueue_t *Q, mpmc_queue_handle_t *h, sncl_mqnode_t *n) {
+    h->retired[h->retired_count++] = n;
+    if (h->retired_count < Q->retire_limit)
+        return;
+
+    // every retired node no hazard pointer names can be reused, at most `2 * max_threads` of them stay behind
+    size_t hazard_count = 0;
+    for (size_t i = 0; i < Q->max_threads; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            sncl_mqnode_t *p = load(&Q->handles[i].hazards[j]);
+            if (p)
+                h->scratch[hazard_count++] = p;
+        }
+    }
+    qsort(h->scratch, hazard_count, sizeof(sncl_mqnode_t *), compare_ptrs);
+
+    size_t kept = 0;
+    for (size_t i = 0; i < h->retired_count; i++) {
+        sncl_mqnode_t *r = h->retired[i];
+        if (bsearch(&r, h->scratch, hazard_count, sizeof(sncl_mqnode_t *), compare_ptrs))
+            h->retired[kept++] = r;
+        else
+            cache_node(Q, h, r);
+    }
+    h->retired_count = kept;
+}
+
+static void free_chain(sncl_mqnode_t *n) {
+    while (n) {
+        sncl_mqnode_t *next = n->next;
+        free(n);
+        n = next;
+    }
+}
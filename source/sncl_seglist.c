@@ -0,0 +1,233 @@
+#include <sncl_seglist.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SEG_LIST_MAX_SEGMENTS 64
+
+typedef struct {
+    uint8_t *segments[SEG_LIST_MAX_SEGMENTS];
+    size_t allocated; // number of segments allocated so far, always the leading ones
+
+    size_t shift; // the first segment holds `1 << shift` elements
+    size_t size;      // claimed indices, only ever ahead of `published` during concurrent pushes
+    size_t published; // indices before this are fully written
+    size_t type_size;
+} seglist_t;
+
+#define segment_start(L, k) ((((size_t)1 << (k)) - 1) << (L)->shift)
+#define segment_length(L, k) ((size_t)1 << ((k) + (L)->shift))
+
+// Every segment is followed by one bit per slot, set by a concurrent push once its value is written. Bits are cleared
+// again as `published` moves past them, so they are all clear whenever no concurrent push is in flight.
+#define ready_offset(L, k) ((segment_length(L, k) * (L)->type_size + 7) & ~(size_t)7)
+#define ready_words(L, k) ((segment_length(L, k) + 63) / 64)
+#define ready_bits(L, segment, k) ((uint64_t *)((segment) + ready_offset(L, k)))
+
+static void locate(seglist_t *L, size_t idx, size_t *k, size_t *offset);
+static uint8_t *new_segment(seglist_t *L, size_t k);
+static void allocate_segment(seglist_t *L);
+static void advance_published(seglist_t *L);
+
+void *seg_list__create(size_t type_size, size_t first_segment) {
+    seglist_t *L = (seglist_t *)malloc(sizeof(seglist_t));
+    if (!L)
+        return NULL;
+
+    memset(L->segments, 0, sizeof(L->segments));
+    L->allocated = 0;
+    L->shift = 0;
+    while (((size_t)1 << L->shift) < first_segment)
+        L->shift++;
+    L->size = 0;
+    L->published = 0;
+    L->type_size = type_size;
+    return (void *)L;
+}
+
+void seg_list__destroy(void *sl) {
+    seglist_t *L = sl;
+    for (size_t k = 0; k < L->allocated; k++)
+        free(L->segments[k]);
+    free(L);
+}
+
+void *seg_list__at(void *sl, size_t idx) {
+    seglist_t *L = sl;
+    // atomic loads so readers can share the list with concurrent pushes, these are plain loads on common targets
+    if (idx >= __atomic_load_n(&L->size, __ATOMIC_RELAXED))
+        return NULL;
+
+    size_t k, offset;
+    locate(L, idx, &k, &offset);
+    return __atomic_load_n(&L->segments[k], __ATOMIC_RELAXED) + offset * L->type_size;
+}
+
+void *seg_list__front(void *sl) { return seg_list__at(sl, 0); }
+
+void *seg_list__back(void *sl) {
+    seglist_t *L = sl;
+    if (L->size == 0)
+        return NULL;
+    return seg_list__at(sl, L->size - 1);
+}
+
+bool seg_list_empty(void *sl) {
+    seglist_t *L = sl;
+    return L->size == 0;
+}
+
+size_t seg_list_size(void *sl) {
+    seglist_t *L = sl;
+    return L->size;
+}
+
+size_t seg_list_capacity(void *sl) {
+    seglist_t *L = sl;
+    return segment_start(L, L->allocated);
+}
+
+size_t seg_list_segment_count(void *sl) {
+    seglist_t *L = sl;
+    if (L->size == 0)
+        return 0;
+
+    size_t k, offset;
+    locate(L, L->size - 1, &k, &offset);
+    return k + 1;
+}
+
+void *seg_list_segment(void *sl, size_t k, size_t *count) {
+    seglist_t *L = sl;
+    size_t start = segment_start(L, k);
+    if (k >= L->allocated || start >= L->size) {
+        *count = 0;
+        return NULL;
+    }
+
+    size_t used = L->size - start;
+    *count = used < segment_length(L, k) ? used : segment_length(L, k);
+    return L->segments[k];
+}
+
+void *seg_list__push_back(void *sl, const void *val) {
+    seglist_t *L = sl;
+    if (L->size == segment_start(L, L->allocated))
+        allocate_segment(L);
+
+    size_t k, offset;
+    locate(L, L->size, &k, &offset);
+    uint8_t *slot = L->segments[k] + offset * L->type_size;
+    memcpy(slot, val, L->type_size);
+    L->published = ++L->size;
+    return slot;
+}
+
+void seg_list__pop_back(void *sl) {
+    seglist_t *L = sl;
+    if (L->size > 0)
+        L->published = --L->size;
+}
+
+void seg_list_clear(void *sl) {
+    seglist_t *L = sl;
+    L->size = 0;
+    L->published = 0;
+}
+
+void seg_list_reserve(void *sl, size_t cap) {
+    seglist_t *L = sl;
+    while (segment_start(L, L->allocated) < cap)
+        allocate_segment(L);
+}
+
+void *seg_list__push_back_concurrent(void *sl, const void *val) {
+    seglist_t *L = sl;
+    size_t idx = __atomic_fetch_add(&L->size, 1, __ATOMIC_RELAXED);
+
+    size_t k, offset;
+    locate(L, idx, &k, &offset);
+    assert(k + L->shift < SEG_LIST_MAX_SEGMENTS - 1 && "segmented list ran out of segments");
+
+    uint8_t *segment = __atomic_load_n(&L->segments[k], __ATOMIC_ACQUIRE);
+    if (!segment) {
+        // racing threads may each allocate the segment, only the first one to install it keeps theirs
+        uint8_t *fresh = new_segment(L, k);
+
+        uint8_t *expected = NULL;
+        if (__atomic_compare_exchange_n(&L->segments[k], &expected, fresh, false, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE)) {
+            segment = fresh;
+            size_t allocated = __atomic_load_n(&L->allocated, __ATOMIC_RELAXED);
+            while (allocated < k + 1 && !__atomic_compare_exchange_n(&L->allocated, &allocated, k + 1, true,
+                                                                     __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                ;
+        } else {
+            free(fresh);
+            segment = expected;
+        }
+    }
+
+    uint8_t *slot = segment + offset * L->type_size;
+    memcpy(slot, val, L->type_size);
+
+    // mark the slot written and carry `published` as far as it goes. A producer that finishes ahead of a slower one
+    // doesn't wait for it, whoever marks the missing slot later carries `published` over both.
+    __atomic_fetch_or(&ready_bits(L, segment, k)[offset / 64], (uint64_t)1 << (offset % 64), __ATOMIC_SEQ_CST);
+    advance_published(L);
+    return slot;
+}
+
+size_t seg_list_published(void *sl) {
+    seglist_t *L = sl;
+    advance_published(L);
+    return __atomic_load_n(&L->published, __ATOMIC_ACQUIRE);
+}
+
+// Moves `published` over every slot that is marked written, clearing the marks behind it. The mark and the loads here
+// are sequentially consistent so a producer marking its slot and one whose slot is just past it can't both miss each
+// other and leave `published` stuck.
+static void advance_published(seglist_t *L) {
+    size_t p = __atomic_load_n(&L->published, __ATOMIC_SEQ_CST);
+    while (p < __atomic_load_n(&L->size, __ATOMIC_SEQ_CST)) {
+        size_t k, offset;
+        locate(L, p, &k, &offset);
+        uint8_t *segment = __atomic_load_n(&L->segments[k], __ATOMIC_ACQUIRE);
+        if (!segment)
+            return; // still being allocated by the producer that claimed `p`
+
+        uint64_t *word = &ready_bits(L, segment, k)[offset / 64];
+        uint64_t bit = (uint64_t)1 << (offset % 64);
+        if (!(__atomic_load_n(word, __ATOMIC_SEQ_CST) & bit))
+            return;
+        // only the thread that moves `published` past the slot clears its mark, a failed exchange reloads `p`
+        if (__atomic_compare_exchange_n(&L->published, &p, p + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            __atomic_fetch_and(word, ~bit, __ATOMIC_RELAXED);
+            p++;
+        }
+    }
+}
+
+// Finds which segment holds `idx` and where in that segment it lives. Segment `k` starts at `base * (2^k - 1)`, so the
+// segment is just the highest set bit of `idx / base + 1`.
+static void locate(seglist_t *L, size_t idx, size_t *k, size_t *offset) {
+    size_t j = (idx >> L->shift) + 1;
+    *k = (size_t)(sizeof(unsigned long long) * 8 - 1 - __builtin_clzll((unsigned long long)j));
+    *offset = idx - segment_start(L, *k);
+}
+
+// Allocates segment `k` along with its cleared ready bits.
+static uint8_t *new_segment(seglist_t *L, size_t k) {
+    uint8_t *segment = (uint8_t *)malloc(ready_offset(L, k) + ready_words(L, k) * sizeof(uint64_t));
+    assert(segment != NULL && "failed to allocate segment when growing segmented list");
+    memset(ready_bits(L, segment, k), 0, ready_words(L, k) * sizeof(uint64_t));
+    return segment;
+}
+
+static void allocate_segment(seglist_t *L) {
+    assert(L->allocated + L->shift < SEG_LIST_MAX_SEGMENTS - 1 && "segmented list ran out of segments");
+    L->segments[L->allocated] = new_segment(L, L->allocated);
+    L->allocated++;
+}
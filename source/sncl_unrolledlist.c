@@ -0,0 +1,389 @@
+#include <sncl_unrolledlist.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct SNCL_ULNode sncl_ulnode_t;
+
+typedef struct {
+    sncl_ulnode_t *first;
+    sncl_ulnode_t *last;
+
+    sncl_ulnode_t *it__;
+    size_t it_offset__;
+    bool it_forward__;
+
+    // the node last reached by a positional access, and the index of its first element
+    sncl_ulnode_t *finger;
+    size_t finger_start;
+
+    size_t size;
+    size_t nodes;
+    size_t type_size;
+    size_t node_capacity;
+} unrolledlist_t;
+
+struct SNCL_ULNode {
+    sncl_ulnode_t *next;
+    sncl_ulnode_t *prev;
+    size_t count;
+    union {
+        char bytes[1];
+        void *align_ptr_;
+        long double align_ld_;
+        long long align_ll_;
+    } data[]; // `node_capacity * type_size` bytes
+};
+
+// bytes of element data a node aims for when no capacity is given
+#define DEFAULT_NODE_BYTES 256
+
+#define elem(L, n, i) ((char *)(n)->data + (i) * (L)->type_size)
+
+static sncl_ulnode_t *new_node(unrolledlist_t *L);
+static void link_after(unrolledlist_t *L, sncl_ulnode_t *at, sncl_ulnode_t *n);
+static void unlink_node(unrolledlist_t *L, sncl_ulnode_t *n);
+static sncl_ulnode_t *locate(unrolledlist_t *L, size_t *offset);
+
+void *unrolled_list__create(size_t type_size, size_t node_capacity) {
+    unrolledlist_t *ul = (unrolledlist_t *)malloc(sizeof(unrolledlist_t));
+    if (!ul)
+        return NULL;
+
+    if (!node_capacity) {
+        node_capacity = type_size ? DEFAULT_NODE_BYTES / type_size : DEFAULT_NODE_BYTES;
+        if (node_capacity < 4)
+            node_capacity = 4;
+    }
+
+    ul->first = NULL;
+    ul->last = NULL;
+    ul->it__ = NULL;
+    ul->it_offset__ = 0;
+    ul->it_forward__ = true;
+    ul->finger = NULL;
+    ul->finger_start = 0;
+    ul->size = 0;
+    ul->nodes = 0;
+    ul->type_size = type_size;
+    ul->node_capacity = node_capacity;
+
+    return (void *)ul;
+}
+
+void unrolled_list__destroy(void *ul) {
+    unrolled_list_clear(ul);
+    free(ul);
+}
+
+void unrolled_list__start(void *ul) {
+    unrolledlist_t *L = ul;
+    L->it__ = L->first;
+    L->it_offset__ = 0;
+    L->it_forward__ = true;
+}
+
+void unrolled_list__rstart(void *ul) {
+    unrolledlist_t *L = ul;
+    L->it__ = L->last;
+    L->it_offset__ = L->last ? L->last->count - 1 : 0;
+    L->it_forward__ = false;
+}
+
+void *unrolled_list__next(void *ul) {
+    unrolledlist_t *L = ul;
+    sncl_ulnode_t *n = L->it__;
+    if (!n)
+        return NULL;
+
+    void *val = elem(L, n, L->it_offset__);
+    if (L->it_forward__) {
+        if (++L->it_offset__ == n->count) {
+            L->it__ = n->next;
+            L->it_offset__ = 0;
+        }
+    } else if (L->it_offset__-- == 0) {
+        L->it__ = n->prev;
+        L->it_offset__ = n->prev ? n->prev->count - 1 : 0;
+    }
+
+    return val;
+}
+
+void *unrolled_list__front(void *ul) {
+    unrolledlist_t *L = ul;
+    return elem(L, L->first, 0);
+}
+
+void *unrolled_list__back(void *ul) {
+    unrolledlist_t *L = ul;
+    return elem(L, L->last, L->last->count - 1);
+}
+
+void *unrolled_list__get(void *ul, size_t offset) {
+    unrolledlist_t *L = ul;
+    if (offset >= L->size)
+        return NULL;
+
+    sncl_ulnode_t *n = locate(L, &offset);
+    return elem(L, n, offset);
+}
+
+bool unrolled_list_empty(void *ul) {
+    unrolledlist_t *L = ul;
+    return L->size == 0;
+}
+
+size_t unrolled_list_size(void *ul) {
+    unrolledlist_t *L = ul;
+    return L->size;
+}
+
+size_t unrolled_list_node_count(void *ul) {
+    unrolledlist_t *L = ul;
+    return L->nodes;
+}
+
+void unrolled_list_clear(void *ul) {
+    unrolledlist_t *L = ul;
+    sncl_ulnode_t *curr = L->first;
+
+    while (curr) {
+        sncl_ulnode_t *next = curr->next;
+        free(curr);
+        curr = next;
+    }
+
+    L->first = L->last = NULL;
+    L->it__ = NULL;
+    L->finger = NULL;
+    L->size = 0;
+    L->nodes = 0;
+}
+
+void unrolled_list__add(void *ul, size_t pos, void *val) {
+    unrolledlist_t *L = ul;
+    if (pos == L->size)
+        return unrolled_list__push_back(ul, val);
+    if (pos > L->size)
+        return;
+
+    size_t offset = pos;
+    sncl_ulnode_t *n = locate(L, &offset);
+
+    // everything from `n` onwards stays where it was relative to the start of `n`, so the finger can sit on it
+    L->finger = n;
+    L->finger_start = pos - offset;
+
+    if (n->count == L->node_capacity) {
+        // split the full node in half, moving the upper half into a new node right after it
+        sncl_ulnode_t *half = new_node(L);
+        if (!half)
+            return;
+
+        size_t keep = n->count / 2;
+        half->count = n->count - keep;
+        memcpy(half->data, elem(L, n, keep), half->count * L->type_size);
+        n->count = keep;
+        link_after(L, n, half);
+
+        if (offset > keep) {
+            n = half;
+            offset -= keep;
+            L->finger = half;
+            L->finger_start += keep;
+        }
+    }
+
+    memmove(elem(L, n, offset + 1), elem(L, n, offset), (n->count - offset) * L->type_size);
+    memcpy(elem(L, n, offset), val, L->type_size);
+    n->count++;
+    L->size++;
+}
+
+void unrolled_list__push_front(void *ul, void *val) {
+    unrolledlist_t *L = ul;
+    sncl_ulnode_t *n = L->first;
+
+    if (!n || n->count == L->node_capacity) {
+        // start a new node rather than splitting, so a run of front pushes fills whole nodes
+        n = new_node(L);
+        if (!n)
+            return;
+        link_after(L, NULL, n);
+    } else {
+        memmove(elem(L, n, 1), elem(L, n, 0), n->count * L->type_size);
+    }
+
+    memcpy(elem(L, n, 0), val, L->type_size);
+    n->count++;
+    L->size++;
+    if (L->finger && L->finger != n)
+        L->finger_start++;
+}
+
+void unrolled_list__push_back(void *ul, void *val) {
+    unrolledlist_t *L = ul;
+    sncl_ulnode_t *n = L->last;
+
+    if (!n || n->count == L->node_capacity) {
+        n = new_node(L);
+        if (!n)
+            return;
+        link_after(L, L->last, n);
+    }
+
+    memcpy(elem(L, n, n->count), val, L->type_size);
+    n->count++;
+    L->size++;
+}
+
+void unrolled_list__remove(void *ul, size_t pos) {
+    unrolledlist_t *L = ul;
+    if (pos >= L->size)
+        return;
+
+    size_t offset = pos;
+    sncl_ulnode_t *n = locate(L, &offset);
+    // merges below can free `n`, so the finger is dropped rather than tracked
+    L->finger = NULL;
+
+    n->count--;
+    memmove(elem(L, n, offset), elem(L, n, offset + 1), (n->count - offset) * L->type_size);
+    L->size--;
+
+    if (n->count == 0) {
+        unlink_node(L, n);
+        return;
+    }
+
+    // merge an under-filled node with a neighbour when both fit in one, keeping nodes at least about half full
+    if (n->count * 2 >= L->node_capacity)
+        return;
+    if (n->next && n->count + n->next->count <= L->node_capacity) {
+        sncl_ulnode_t *next = n->next;
+        memcpy(elem(L, n, n->count), next->data, next->count * L->type_size);
+        n->count += next->count;
+        unlink_node(L, next);
+    } else if (n->prev && n->count + n->prev->count <= L->node_capacity) {
+        sncl_ulnode_t *prev = n->prev;
+        memcpy(elem(L, prev, prev->count), n->data, n->count * L->type_size);
+        prev->count += n->count;
+        unlink_node(L, n);
+    }
+}
+
+void unrolled_list__pop_front(void *ul) {
+    unrolledlist_t *L = ul;
+    sncl_ulnode_t *n = L->first;
+    if (!n)
+        return;
+
+    // no merging at the ends, a run of pops just drains the end node
+    n->count--;
+    memmove(elem(L, n, 0), elem(L, n, 1), n->count * L->type_size);
+    L->size--;
+    if (L->finger && L->finger != n)
+        L->finger_start--;
+    if (n->count == 0)
+        unlink_node(L, n);
+}
+
+void unrolled_list__pop_back(void *ul) {
+    unrolledlist_t *L = ul;
+    sncl_ulnode_t *n = L->last;
+    if (!n)
+        return;
+
+    n->count--;
+    L->size--;
+    if (n->count == 0)
+        unlink_node(L, n);
+}
+
+static sncl_ulnode_t *new_node(unrolledlist_t *L) {
+    sncl_ulnode_t *n = malloc(sizeof(sncl_ulnode_t) + L->node_capacity * L->type_size);
+    if (!n)
+        return NULL;
+
+    n->next = NULL;
+    n->prev = NULL;
+    n->count = 0;
+    return n;
+}
+
+// links `n` after `at`, or at the front when `at` is `NULL`
+static void link_after(unrolledlist_t *L, sncl_ulnode_t *at, sncl_ulnode_t *n) {
+    n->prev = at;
+    n->next = at ? at->next : L->first;
+
+    if (n->next)
+        n->next->prev = n;
+    else
+        L->last = n;
+
+    if (at)
+        at->next = n;
+    else
+        L->first = n;
+
+    L->nodes++;
+}
+
+static void unlink_node(unrolledlist_t *L, sncl_ulnode_t *n) {
+    if (n->prev)
+        n->prev->next = n->next;
+    else
+        L->first = n->next;
+
+    if (n->next)
+        n->next->prev = n->prev;
+    else
+        L->last = n->prev;
+
+    if (L->finger == n)
+        L->finger = NULL;
+
+    // the internal iterator moves on rather than dangling
+    if (L->it__ == n) {
+        L->it__ = L->it_forward__ ? n->next : n->prev;
+        L->it_offset__ = L->it_forward__ || !n->prev ? 0 : n->prev->count - 1;
+    }
+
+    free(n);
+    L->nodes--;
+}
+
+// finds the node holding element `*offset`, walking whole nodes from the nearest of either end and the finger, and
+// turns `*offset` into the index within that node. `*offset` must be below the size.
+static sncl_ulnode_t *locate(unrolledlist_t *L, size_t *offset) {
+    size_t idx = *offset;
+    sncl_ulnode_t *n = L->first;
+    size_t start = 0;
+
+    if (idx >= L->size / 2) {
+        n = L->last;
+        start = L->size - n->count;
+    }
+    if (L->finger) {
+        size_t dist = idx > L->finger_start ? idx - L->finger_start : L->finger_start - idx;
+        if (dist < (idx > start ? idx - start : start - idx)) {
+            n = L->finger;
+            start = L->finger_start;
+        }
+    }
+
+    while (idx >= start + n->count) {
+        start += n->count;
+        n = n->next;
+    }
+    while (idx < start) {
+        n = n->prev;
+        start -= n->count;
+    }
+
+    L->finger = n;
+    L->finger_start = start;
+    *offset = idx - start;
+    return n;
+}
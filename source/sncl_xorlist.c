@@ -0,0 +1,278 @@
+#include <sncl_xorlist.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct SNCL_XLSlab sncl_xlslab_t;
+
+typedef struct {
+    char *first;
+    char *last;
+
+    size_t size;
+    size_t type_size;
+
+    // nodes are carved out of slabs in order, and freed nodes go on a free list that is drawn from first
+    sncl_xlslab_t *slabs;   // every slab, in the order they are carved from
+    sncl_xlslab_t *current; // the slab nodes are being carved from
+    size_t carved;          // nodes carved from the current slab so far
+    char *free_list;        // chained through the link field
+    size_t node_size;
+    size_t data_offset;
+    size_t slab_bytes; // bytes held by every slab together
+} xorlist_t;
+
+struct SNCL_XLSlab {
+    sncl_xlslab_t *next;
+    size_t nodes;
+    union {
+        char bytes[1];
+        void *align_ptr_;
+        long double align_ld_;
+        long long align_ll_;
+    } data[]; // `nodes` nodes of `node_size` bytes each
+};
+
+// slabs start small for short lists and double up to this many nodes
+#define FIRST_SLAB_NODES 64
+#define MAX_SLAB_NODES 65536
+
+#define link(n) (*(uintptr_t *)(n))
+#define xor_ptr(a, b) ((char *)((uintptr_t)(a) ^ (uintptr_t)(b)))
+
+static char *new_node(xorlist_t *L, void *val);
+static void free_node(xorlist_t *L, char *n);
+
+void *xor_list__create(size_t type_size) {
+    xorlist_t *xl = (xorlist_t *)malloc(sizeof(xorlist_t));
+    if (!xl)
+        return NULL;
+
+    // elements get the largest power of two alignment their size allows, so small elements are not padded out to the
+    // strictest alignment like pooled linkedlist nodes are
+    size_t align = sizeof(((sncl_xlslab_t *)0)->data[0]);
+    while (align > sizeof(uintptr_t) && type_size % align != 0)
+        align /= 2;
+
+    xl->first = NULL;
+    xl->last = NULL;
+    xl->size = 0;
+    xl->type_size = type_size;
+    xl->slabs = NULL;
+    xl->current = NULL;
+    xl->carved = 0;
+    xl->free_list = NULL;
+    xl->data_offset = align;
+    xl->node_size = (align + type_size + align - 1) / align * align;
+    xl->slab_bytes = 0;
+
+    return (void *)xl;
+}
+
+void xor_list__destroy(void *xl) {
+    xorlist_t *L = xl;
+    sncl_xlslab_t *slab = L->slabs;
+    while (slab) {
+        sncl_xlslab_t *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    free(L);
+}
+
+xor_list_iter_t xor_list_begin(void *xl) {
+    xorlist_t *L = xl;
+    xor_list_iter_t it = { NULL, L->first };
+    return it;
+}
+
+xor_list_iter_t xor_list_rbegin(void *xl) {
+    xorlist_t *L = xl;
+    xor_list_iter_t it = { NULL, L->last };
+    return it;
+}
+
+void *xor_list_iter_get(void *xl, xor_list_iter_t *it) {
+    xorlist_t *L = xl;
+    return it->curr ? (char *)it->curr + L->data_offset : NULL;
+}
+
+void xor_list_iter_next(__attribute__((unused)) void *xl, xor_list_iter_t *it) {
+    if (!it->curr)
+        return;
+    char *next = xor_ptr(link(it->curr), it->prev);
+    it->prev = it->curr;
+    it->curr = next;
+}
+
+void xor_list_iter_remove(void *xl, xor_list_iter_t *it) {
+    xorlist_t *L = xl;
+    char *curr = it->curr, *prev = it->prev;
+    if (!curr)
+        return;
+
+    char *next = xor_ptr(link(curr), prev);
+    if (prev)
+        link(prev) ^= (uintptr_t)curr ^ (uintptr_t)next;
+    if (next)
+        link(next) ^= (uintptr_t)curr ^ (uintptr_t)prev;
+
+    // the iterator may run either way, so an end it touches is either the first or the last node
+    if (!prev) {
+        if (L->first == curr)
+            L->first = next;
+        else
+            L->last = next;
+    }
+    if (!next) {
+        if (L->last == curr)
+            L->last = prev;
+        else
+            L->first = prev;
+    }
+
+    free_node(L, curr);
+    L->size--;
+    it->curr = next;
+}
+
+void *xor_list__front(void *xl) {
+    xorlist_t *L = xl;
+    return L->first + L->data_offset;
+}
+
+void *xor_list__back(void *xl) {
+    xorlist_t *L = xl;
+    return L->last + L->data_offset;
+}
+
+bool xor_list_empty(void *xl) {
+    xorlist_t *L = xl;
+    return L->size == 0;
+}
+
+size_t xor_list_size(void *xl) {
+    xorlist_t *L = xl;
+    return L->size;
+}
+
+size_t xor_list_memory_usage(void *xl) {
+    xorlist_t *L = xl;
+    return sizeof(xorlist_t) + L->slab_bytes;
+}
+
+void xor_list_clear(void *xl) {
+    xorlist_t *L = xl;
+    L->current = L->slabs;
+    L->carved = 0;
+    L->free_list = NULL;
+    L->first = L->last = NULL;
+    L->size = 0;
+}
+
+void xor_list__push_front(void *xl, void *val) {
+    xorlist_t *L = xl;
+    char *n = new_node(L, val);
+    if (!n)
+        return;
+
+    link(n) = (uintptr_t)L->first;
+    if (L->first)
+        link(L->first) ^= (uintptr_t)n;
+    else
+        L->last = n;
+
+    L->first = n;
+    L->size++;
+}
+
+void xor_list__push_back(void *xl, void *val) {
+    xorlist_t *L = xl;
+    char *n = new_node(L, val);
+    if (!n)
+        return;
+
+    link(n) = (uintptr_t)L->last;
+    if (L->last)
+        link(L->last) ^= (uintptr_t)n;
+    else
+        L->first = n;
+
+    L->last = n;
+    L->size++;
+}
+
+void xor_list__pop_front(void *xl) {
+    xorlist_t *L = xl;
+    char *n = L->first;
+    if (!n)
+        return;
+
+    // the first node's link is just its next node
+    L->first = (char *)link(n);
+    if (L->first)
+        link(L->first) ^= (uintptr_t)n;
+    else
+        L->last = NULL;
+
+    free_node(L, n);
+    L->size--;
+}
+
+void xor_list__pop_back(void *xl) {
+    xorlist_t *L = xl;
+    char *n = L->last;
+    if (!n)
+        return;
+
+    L->last = (char *)link(n);
+    if (L->last)
+        link(L->last) ^= (uintptr_t)n;
+    else
+        L->first = NULL;
+
+    free_node(L, n);
+    L->size--;
+}
+
+static char *new_node(xorlist_t *L, void *val) {
+    char *n;
+
+    if (L->free_list) {
+        n = L->free_list;
+        L->free_list = (char *)link(n);
+    } else {
+        if (!L->current || L->carved == L->current->nodes) {
+            // move on to the next slab, only allocating one when every slab has been carved up
+            sncl_xlslab_t *next = L->current ? L->current->next : L->slabs;
+            if (!next) {
+                size_t nodes = L->current ? L->current->nodes * 2 : FIRST_SLAB_NODES;
+                if (nodes > MAX_SLAB_NODES)
+                    nodes = MAX_SLAB_NODES;
+
+                next = (sncl_xlslab_t *)malloc(sizeof(sncl_xlslab_t) + nodes * L->node_size);
+                if (!next)
+                    return NULL;
+                next->next = NULL;
+                next->nodes = nodes;
+                L->slab_bytes += sizeof(sncl_xlslab_t) + nodes * L->node_size;
+                if (L->current)
+                    L->current->next = next;
+                else
+                    L->slabs = next;
+            }
+            L->current = next;
+            L->carved = 0;
+        }
+        n = (char *)L->current->data + L->carved++ * L->node_size;
+    }
+
+    memcpy(n + L->data_offset, val, L->type_size);
+    return n;
+}
+
+static void free_node(xorlist_t *L, char *n) {
+    link(n) = (uintptr_t)L->free_list;
+    L->free_list = n;
+}
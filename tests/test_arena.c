@@ -0,0 +1,93 @@
+#include <sncl_test.h>
+
+#include <sncl_arena.h>
+#include <sncl_arraylist.h>
+
+#include <stdint.h>
+
+TEST_CASE(Arena_AllocAligned) {
+    sncl_arena_t *arena = sncl_arena_create(0);
+
+    for (size_t i = 1; i < 64; i++) {
+        void *p = sncl_arena_alloc(arena, i);
+        ASSERT_TRUE(p != NULL);
+        ASSERT_EQUAL((uintptr_t)p % sizeof(long double), 0);
+    }
+
+    sncl_arena_destroy(arena);
+    return 0;
+}
+
+TEST_CASE(Arena_LargeAllocation) {
+    sncl_arena_t *arena = sncl_arena_create(256);
+
+    uint8_t *p = sncl_arena_alloc(arena, 4096);
+    ASSERT_TRUE(p != NULL);
+    memset(p, 0xAB, 4096);
+    ASSERT_TRUE(sncl_arena_reserved(arena) >= 4096);
+
+    sncl_arena_destroy(arena);
+    return 0;
+}
+
+TEST_CASE(Arena_ReallocInPlace) {
+    sncl_arena_t *arena = sncl_arena_create(1024);
+
+    int *p = sncl_arena_alloc(arena, 4 * sizeof(int));
+    for (int i = 0; i < 4; i++)
+        p[i] = i;
+
+    int *q = sncl_arena_realloc(arena, p, 4 * sizeof(int), 8 * sizeof(int));
+    ASSERT_TRUE(p == q);
+
+    sncl_arena_alloc(arena, 16);
+    int *r = sncl_arena_realloc(arena, q, 8 * sizeof(int), 16 * sizeof(int));
+    ASSERT_TRUE(r != q);
+    for (int i = 0; i < 4; i++)
+        ASSERT_EQUAL(r[i], i);
+
+    sncl_arena_destroy(arena);
+    return 0;
+}
+
+TEST_CASE(Arena_ResetReusesBlocks) {
+    sncl_arena_t *arena = sncl_arena_create(512);
+
+    for (int i = 0; i < 32; i++)
+        sncl_arena_alloc(arena, 128);
+    size_t reserved = sncl_arena_reserved(arena);
+
+    sncl_arena_reset(arena);
+    for (int i = 0; i < 32; i++)
+        sncl_arena_alloc(arena, 128);
+
+    ASSERT_EQUAL(sncl_arena_reserved(arena), reserved);
+
+    sncl_arena_destroy(arena);
+    return 0;
+}
+
+TEST_CASE(Arena_ArrayListBacked) {
+    sncl_arena_t *arena = sncl_arena_create(0);
+
+    array_list(int) list = array_list_new_with(int, sncl_arena_allocator(arena));
+    ASSERT_TRUE(array_list_allocator(list) == sncl_arena_allocator(arena));
+
+    for (int i = 0; i < 1000; i++)
+        array_list_push_back(list, i);
+
+    ASSERT_EQUAL(array_list_size(list), 1000);
+    for (int i = 0; i < 1000; i++)
+        ASSERT_EQUAL(array_list_at(list, i), i);
+
+    // no per-list free needed, the reset releases it
+    sncl_arena_reset(arena);
+
+    array_list(int) other = array_list_new_with(int, sncl_arena_allocator(arena));
+    array_list_push_back(other, (int){ 7 });
+    ASSERT_EQUAL(array_list_front(other), 7);
+    array_list_destroy((void *)other);
+
+    sncl_arena_destroy(arena);
+    return 0;
+}
@@ -2,6 +2,13 @@
 
 #include <sncl_arraylist.h>
 
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 BEFORE_ALL() {}
 
 BEFORE_EACH() {}
@@ -174,3 +181,477 @@ TEST_CASE(ArrayList_ReservePreservesData) {
     array_list_destroy((void *)list);
     return 0;
 }
+
+typedef struct {
+    int allocs;
+    int reallocs;
+    int frees;
+} counting_ctx_t;
+
+static void *counting_alloc(void *ctx, size_t size) {
+    ((counting_ctx_t *)ctx)->allocs++;
+    return malloc(size);
+}
+
+static void *counting_realloc(void *ctx, void *ptr, __attribute__((unused)) size_t old_size, size_t new_size) {
+    ((counting_ctx_t *)ctx)->reallocs++;
+    return realloc(ptr, new_size);
+}
+
+static void counting_free(void *ctx, void *ptr, __attribute__((unused)) size_t size) {
+    ((counting_ctx_t *)ctx)->frees++;
+    free(ptr);
+}
+
+TEST_CASE(ArrayList_CustomAllocator) {
+    counting_ctx_t counts = { 0, 0, 0 };
+    sncl_allocator_t allocator = { counting_alloc, counting_realloc, counting_free, &counts };
+
+    array_list(int) list = array_list_new_with(int, &allocator);
+    for (int i = 0; i < 100; i++)
+        array_list_push_back(list, i);
+
+    ASSERT_EQUAL(array_list_size(list), 100);
+    ASSERT_EQUAL(array_list_at(list, 99), 99);
+    ASSERT_TRUE(array_list_allocator(list) == &allocator);
+
+    array_list_destroy((void *)list);
+
+    ASSERT_EQUAL(counts.allocs, 1);
+    ASSERT_TRUE(counts.reallocs > 0);
+    ASSERT_EQUAL(counts.frees, 1);
+    return 0;
+}
+
+TEST_CASE(ArrayList_NewWithCapacity) {
+    array_list(int) list = array_list_new_with_capacity(int, 3);
+
+    ASSERT_EQUAL(array_list_capacity(list), 3);
+    for (int i = 0; i < 4; i++)
+        array_list_push_back(list, i);
+    ASSERT_EQUAL(array_list_capacity(list), 6);
+
+    array_list_destroy((void *)list);
+
+    array_list(int) empty = array_list_new_with_capacity(int, 0);
+    array_list_push_back(empty, (int){ 5 });
+    ASSERT_EQUAL(array_list_front(empty), 5);
+    array_list_destroy((void *)empty);
+    return 0;
+}
+
+TEST_CASE(ArrayList_GrowthPolicies) {
+    array_list(int) half = array_list_new_with_capacity(int, 10);
+    array_list_set_growth(half, ARRAY_LIST_GROW_HALF, 0);
+    for (int i = 0; i < 11; i++)
+        array_list_push_back(half, i);
+    ASSERT_EQUAL(array_list_capacity(half), 16);
+    array_list_destroy((void *)half);
+
+    array_list(int) fixed = array_list_new_with_capacity(int, 10);
+    array_list_set_growth(fixed, ARRAY_LIST_GROW_FIXED, 100);
+    ASSERT_EQUAL(array_list_growth(fixed), ARRAY_LIST_GROW_FIXED);
+    for (int i = 0; i < 11; i++)
+        array_list_push_back(fixed, i);
+    ASSERT_EQUAL(array_list_capacity(fixed), 110);
+    array_list_destroy((void *)fixed);
+
+    array_list(int) paged = array_list_new_with_capacity(int, 4);
+    array_list_set_growth(paged, ARRAY_LIST_GROW_PAGED, 1024);
+    for (int i = 0; i < 5000; i++)
+        array_list_push_back(paged, i);
+    for (int i = 0; i < 5000; i++)
+        ASSERT_EQUAL(array_list_at(paged, i), i);
+    array_list_destroy((void *)paged);
+    return 0;
+}
+
+TEST_CASE(ArrayList_ShrinkToFit) {
+    array_list(int) list = array_list_new(int);
+
+    for (int i = 0; i < 20; i++)
+        array_list_push_back(list, i);
+    ASSERT_TRUE(array_list_capacity(list) > 20);
+
+    array_list_shrink_to_fit(list);
+    ASSERT_EQUAL(array_list_capacity(list), 20);
+    for (int i = 0; i < 20; i++)
+        ASSERT_EQUAL(array_list_at(list, i), i);
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(ArrayList_GrowthCounters) {
+    array_list(int) list = array_list_new_with_capacity(int, 1);
+
+    ASSERT_EQUAL(array_list_reallocations(list), 0);
+    for (int i = 0; i < 1024; i++)
+        array_list_push_back(list, i);
+
+    // 1 -> 2 -> 4 -> ... -> 1024
+    ASSERT_EQUAL(array_list_reallocations(list), 10);
+    ASSERT_TRUE(array_list_bytes_copied(list) <= 1023 * sizeof(int));
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(ArrayList_Aligned) {
+    size_t alignments[] = { 16, 32, 64, 4096 };
+
+    for (size_t a = 0; a < sizeof(alignments) / sizeof(alignments[0]); a++) {
+        array_list(float) list = array_list_new_aligned(float, alignments[a]);
+        ASSERT_EQUAL(array_list_alignment(list), alignments[a]);
+        ASSERT_EQUAL((uintptr_t)list % alignments[a], 0);
+
+        for (int i = 0; i < 10000; i++) {
+            float f = (float)i;
+            array_list_push_back(list, f);
+            ASSERT_EQUAL((uintptr_t)list % alignments[a], 0);
+        }
+        for (int i = 0; i < 10000; i++)
+            ASSERT_TRUE(array_list_at(list, i) == (float)i);
+
+        array_list_shrink_to_fit(list);
+        ASSERT_EQUAL((uintptr_t)list % alignments[a], 0);
+        ASSERT_TRUE(array_list_back(list) == 9999.0f);
+
+        array_list_destroy((void *)list);
+    }
+    return 0;
+}
+
+TEST_CASE(ArrayList_Mapped) {
+    const char *path = "test_arraylist_mapped.bin";
+    unlink(path);
+
+    array_list(int) list = array_list_map(int, path, ARRAY_LIST_MAP_READ_WRITE);
+    ASSERT_TRUE(list != NULL);
+    ASSERT_TRUE(array_list_is_mapped(list));
+    ASSERT_TRUE(array_list_empty(list));
+
+    for (int i = 0; i < 5000; i++)
+        array_list_push_back(list, i);
+    ASSERT_TRUE(array_list_flush(list));
+    ASSERT_TRUE(array_list_allocator(list) == NULL);
+    array_list_destroy((void *)list);
+
+    // the allocator slot that starts the file must never hold an address from this process
+    FILE *file = fopen(path, "rb");
+    uintptr_t slot = 0;
+    ASSERT_TRUE(file != NULL);
+    ASSERT_EQUAL(fread(&slot, sizeof(slot), 1, file), 1);
+    fclose(file);
+    ASSERT_TRUE(slot < 4096);
+
+    list = array_list_map(int, path, ARRAY_LIST_MAP_READ_WRITE);
+    ASSERT_TRUE(list != NULL);
+    ASSERT_EQUAL(array_list_size(list), 5000);
+    for (int i = 0; i < 5000; i++)
+        ASSERT_EQUAL(array_list_at(list, i), i);
+    array_list_shrink_to_fit(list);
+    ASSERT_EQUAL(array_list_capacity(list), 5000);
+    array_list_destroy((void *)list);
+
+    array_list(int) reader = array_list_map(int, path, ARRAY_LIST_MAP_READ_ONLY);
+    ASSERT_TRUE(reader != NULL);
+    ASSERT_EQUAL(array_list_size(reader), 5000);
+    ASSERT_EQUAL(array_list_back(reader), 4999);
+    ASSERT_FALSE(array_list_flush(reader));
+    // it was shrunk to fit, so growing has to be turned down without touching it
+    int extra = 5000;
+    array_list_push_back(reader, extra);
+    ASSERT_EQUAL(array_list_size(reader), 5000);
+    ASSERT_TRUE(array_list_emplace_back(reader) == NULL);
+    ASSERT_EQUAL(array_list_back(reader), 4999);
+    array_list_destroy((void *)reader);
+
+    ASSERT_TRUE(array_list_map(double, path, ARRAY_LIST_MAP_READ_ONLY) == NULL);
+    ASSERT_TRUE(array_list_map(int, "does/not/exist.bin", ARRAY_LIST_MAP_READ_ONLY) == NULL);
+
+    unlink(path);
+    return 0;
+}
+
+TEST_CASE(ArrayList_InlineStorage) {
+    array_list_inline_storage(int, 8, storage);
+    array_list(int) list = array_list_new_inline(int, storage);
+
+    ASSERT_TRUE(array_list_is_inline(list));
+    ASSERT_TRUE(array_list_capacity(list) >= 8);
+    ASSERT_TRUE((void *)list > (void *)&storage && (void *)list < (void *)(&storage + 1));
+
+    for (int i = 0; i < 8; i++)
+        array_list_push_back(list, i);
+    ASSERT_TRUE(array_list_is_inline(list));
+
+    array_list_shrink_to_fit(list);
+    ASSERT_TRUE(array_list_is_inline(list));
+
+    for (int i = 8; i < 100; i++)
+        array_list_push_back(list, i);
+
+    ASSERT_FALSE(array_list_is_inline(list));
+    ASSERT_TRUE(array_list_allocator(list) == NULL);
+    ASSERT_EQUAL(array_list_size(list), 100);
+    for (int i = 0; i < 100; i++)
+        ASSERT_EQUAL(array_list_at(list, i), i);
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(ArrayList_InlineNeverSpilled) {
+    array_list_inline_storage(double, 4, storage);
+    array_list(double) list = array_list_new_inline(double, storage);
+
+    double d = 1.5;
+    array_list_push_back(list, d);
+    ASSERT_TRUE(array_list_front(list) == 1.5);
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(ArrayList_PushBackN) {
+    array_list(int) list = array_list_new_with_capacity(int, 4);
+
+    int values[1000];
+    for (int i = 0; i < 1000; i++)
+        values[i] = i;
+
+    array_list_push_back_n(list, values, 1000);
+    ASSERT_EQUAL(array_list_size(list), 1000);
+    ASSERT_EQUAL(array_list_reallocations(list), 1);
+    for (int i = 0; i < 1000; i++)
+        ASSERT_EQUAL(array_list_at(list, i), i);
+
+    // appending the list to itself forces a reallocation mid-copy
+    array_list_shrink_to_fit(list);
+    array_list_push_back_n(list, list, 1000);
+    ASSERT_EQUAL(array_list_size(list), 2000);
+    for (int i = 0; i < 2000; i++)
+        ASSERT_EQUAL(array_list_at(list, i), i % 1000);
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(ArrayList_EmplaceBack) {
+    typedef struct {
+        int x, y;
+    } point_t;
+
+    array_list(point_t) list = array_list_new(point_t);
+
+    point_t *p = array_list_emplace_back(list);
+    p->x = 1;
+    p->y = 2;
+
+    point_t *many = array_list_emplace_back_n(list, 3);
+    for (int i = 0; i < 3; i++)
+        many[i] = (point_t){ i, -i };
+
+    ASSERT_EQUAL(array_list_size(list), 4);
+    ASSERT_EQUAL(array_list_front(list).y, 2);
+    ASSERT_EQUAL(array_list_back(list).y, -2);
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(ArrayList_PushBackRvalue) {
+    typedef struct {
+        int x, y;
+    } point_t;
+
+    array_list(int) ints = array_list_new(int);
+    array_list(point_t) points = array_list_new(point_t);
+
+    for (int i = 0; i < 20; i++)
+        array_list_push_back_rv(ints, i * 3);
+    array_list_push_back_rv(points, .x = 4, .y = 5);
+    array_list_push_back_rv(points, 6, 7);
+
+    ASSERT_EQUAL(array_list_size(ints), 20);
+    ASSERT_EQUAL(array_list_back(ints), 57);
+    ASSERT_EQUAL(array_list_at(points, 0).y, 5);
+    ASSERT_EQUAL(array_list_at(points, 1).x, 6);
+
+    array_list_destroy((void *)ints);
+    array_list_destroy((void *)points);
+    return 0;
+}
+
+TEST_CASE(ArrayList_PushBackSelf) {
+    array_list(int) list = array_list_new_with_capacity(int, 1);
+    int first = 42;
+    array_list_push_back(list, first);
+
+    // each push reads from the list while it may be reallocating
+    for (int i = 0; i < 100; i++)
+        array_list_push_back(list, list[0]);
+
+    ASSERT_EQUAL(array_list_size(list), 101);
+    ASSERT_EQUAL(array_list_back(list), 42);
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+SNCL_ARRAYLIST_DEFINE(int, intlist)
+
+TEST_CASE(ArrayList_TypedDefine) {
+    int *list = intlist_new_with_capacity(2);
+
+    for (int i = 0; i < 100; i++)
+        intlist_push_back(&list, i * 2);
+    *intlist_emplace_back(&list) = -1;
+
+    ASSERT_EQUAL(intlist_size(list), 101);
+    ASSERT_TRUE(intlist_capacity(list) >= 101);
+    ASSERT_EQUAL(intlist_at(list, 50), 100);
+    ASSERT_EQUAL(intlist_front(list), 0);
+    ASSERT_EQUAL(intlist_pop_back(list), -1);
+    ASSERT_EQUAL(intlist_back(list), 198);
+    ASSERT_EQUAL(intlist_end(list) - intlist_begin(list), 100);
+
+    // the generic API sees the same list
+    ASSERT_EQUAL(array_list_size(list), 100);
+    ASSERT_EQUAL(array_list_back(list), 198);
+    int extra = 7;
+    array_list_push_back(list, extra);
+    ASSERT_EQUAL(intlist_back(list), 7);
+
+    intlist_reserve(&list, 1000);
+    ASSERT_TRUE(intlist_capacity(list) >= 1000);
+    intlist_clear(list);
+    ASSERT_TRUE(intlist_empty(list));
+
+    intlist_destroy(list);
+    return 0;
+}
+
+static bool is_multiple(const void *elem, void *ctx) { return *(const int *)elem % *(int *)ctx == 0; }
+
+TEST_CASE(ArrayList_EraseIf) {
+    array_list(int) list = array_list_new(int);
+    for (int i = 0; i < 1000; i++)
+        array_list_push_back(list, i);
+
+    int three = 3;
+    ASSERT_EQUAL(array_list_erase_if(list, is_multiple, &three), 334);
+    ASSERT_EQUAL(array_list_size(list), 666);
+    for (size_t i = 0; i < array_list_size(list); i++) {
+        ASSERT_TRUE(array_list_at(list, i) % 3 != 0);
+        if (i > 0)
+            ASSERT_TRUE(array_list_at(list, i - 1) < array_list_at(list, i));
+    }
+
+    int huge = 100000;
+    ASSERT_EQUAL(array_list_erase_if(list, is_multiple, &huge), 0);
+    int one = 1;
+    ASSERT_EQUAL(array_list_erase_if(list, is_multiple, &one), 666);
+    ASSERT_TRUE(array_list_empty(list));
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(ArrayList_SwapRemove) {
+    array_list(int) list = array_list_new(int);
+    for (int i = 0; i < 5; i++)
+        array_list_push_back(list, i);
+
+    array_list_swap_remove(list, 1);
+    ASSERT_EQUAL(array_list_size(list), 4);
+    ASSERT_EQUAL(array_list_at(list, 1), 4);
+
+    array_list_swap_remove(list, 3);
+    ASSERT_EQUAL(array_list_size(list), 3);
+    ASSERT_EQUAL(array_list_back(list), 2);
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(ArrayList_EraseIndices) {
+    array_list(int) list = array_list_new(int);
+    for (int i = 0; i < 10; i++)
+        array_list_push_back(list, i);
+
+    size_t indices[] = { 0, 3, 4, 9 };
+    array_list_erase_indices(list, indices, 4);
+
+    int expected[] = { 1, 2, 5, 6, 7, 8 };
+    ASSERT_EQUAL(array_list_size(list), 6);
+    for (size_t i = 0; i < 6; i++)
+        ASSERT_EQUAL(array_list_at(list, i), expected[i]);
+
+    array_list_erase_indices(list, NULL, 0);
+    ASSERT_EQUAL(array_list_size(list), 6);
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(ArrayList_WriteReadView) {
+    const char *path = "test_arraylist_view.bin";
+
+    array_list(double) list = array_list_new(double);
+    for (int i = 0; i < 3000; i++) {
+        double v = i * 0.25;
+        array_list_push_back(list, v);
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_TRUE(array_list_write(fd, (void *)list));
+    array_list_destroy((void *)list);
+
+    off_t length = lseek(fd, 0, SEEK_END);
+    void *mapping = mmap(NULL, (size_t)length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ASSERT_TRUE(mapping != MAP_FAILED);
+
+    array_list(double) view = array_list_read_view(mapping, (size_t)length);
+    ASSERT_TRUE(view != NULL);
+    ASSERT_TRUE(array_list_is_view(view));
+    ASSERT_TRUE((void *)view > mapping && (void *)view < (void *)((char *)mapping + length));
+    ASSERT_TRUE(array_list_allocator(view) == NULL);
+    ASSERT_EQUAL(array_list_size(view), 3000);
+    for (int i = 0; i < 3000; i++)
+        ASSERT_TRUE(array_list_at(view, i) == i * 0.25);
+    array_list_destroy((void *)view);
+
+    // truncated or foreign buffers are rejected
+    ASSERT_TRUE(array_list_read_view(mapping, (size_t)length - 1) == NULL);
+    ASSERT_TRUE(array_list_read_view(mapping, 16) == NULL);
+    munmap(mapping, (size_t)length);
+
+    static union {
+        unsigned char bytes[4096];
+        double align_;
+    } garbage;
+    memset(garbage.bytes, 0xAB, sizeof(garbage.bytes));
+    ASSERT_TRUE(array_list_read_view(garbage.bytes, sizeof(garbage.bytes)) == NULL);
+
+    // an empty list round trips too
+    array_list(int) empty = array_list_new(int);
+    close(fd);
+    fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_TRUE(array_list_write(fd, (void *)empty));
+    array_list_destroy((void *)empty);
+
+    length = lseek(fd, 0, SEEK_END);
+    mapping = mmap(NULL, (size_t)length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ASSERT_TRUE(mapping != MAP_FAILED);
+    array_list(int) empty_view = array_list_read_view(mapping, (size_t)length);
+    ASSERT_TRUE(empty_view != NULL && array_list_empty(empty_view));
+    munmap(mapping, (size_t)length);
+
+    close(fd);
+    unlink(path);
+    return 0;
+}
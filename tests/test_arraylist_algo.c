@@ -0,0 +1,347 @@
+#include <sncl_test.h>
+
+#include <sncl_arraylist.h>
+#include <sncl_arraylist_algo.h>
+
+#include <pthread.h>
+
+TEST_CASE(ArrayListAlgo_FindEachSize) {
+    array_list(int8_t) l8 = array_list_new(int8_t);
+    array_list(int16_t) l16 = array_list_new(int16_t);
+    array_list(int32_t) l32 = array_list_new(int32_t);
+    array_list(int64_t) l64 = array_list_new(int64_t);
+
+    // long enough to go through the vector loops and their scalar tails
+    for (int i = 0; i < 203; i++) {
+        int8_t v8 = (int8_t)(i % 100);
+        int16_t v16 = (int16_t)i;
+        int32_t v32 = i;
+        int64_t v64 = (int64_t)i << 33;
+        array_list_push_back(l8, v8);
+        array_list_push_back(l16, v16);
+        array_list_push_back(l32, v32);
+        array_list_push_back(l64, v64);
+    }
+
+    for (int i = 0; i < 203; i++) {
+        int8_t v8 = (int8_t)(i % 100);
+        int16_t v16 = (int16_t)i;
+        int32_t v32 = i;
+        int64_t v64 = (int64_t)i << 33;
+        ASSERT_EQUAL(array_list_find(l8, v8) - array_list_begin(l8), i % 100);
+        ASSERT_EQUAL(array_list_find(l16, v16) - array_list_begin(l16), i);
+        ASSERT_EQUAL(array_list_find(l32, v32) - array_list_begin(l32), i);
+        ASSERT_EQUAL(array_list_find(l64, v64) - array_list_begin(l64), i);
+    }
+
+    // only the low halves match, which must not count as a 64-bit match
+    int64_t low_only = 0x100000000;
+    ASSERT_TRUE(array_list_find(l64, low_only) == array_list_end(l64));
+
+    int32_t missing = -1;
+    ASSERT_TRUE(array_list_find(l32, missing) == array_list_end(l32));
+    ASSERT_FALSE(array_list_contains(l32, missing));
+
+    array_list_destroy((void *)l8);
+    array_list_destroy((void *)l16);
+    array_list_destroy((void *)l32);
+    array_list_destroy((void *)l64);
+    return 0;
+}
+
+TEST_CASE(ArrayListAlgo_FindOddSize) {
+    typedef struct {
+        char name[3];
+    } tag_t;
+
+    array_list(tag_t) list = array_list_new(tag_t);
+    tag_t a = { "ab" }, b = { "cd" };
+    for (int i = 0; i < 10; i++)
+        array_list_push_back(list, a);
+    array_list_push_back(list, b);
+
+    ASSERT_EQUAL(array_list_find(list, b) - array_list_begin(list), 10);
+    ASSERT_EQUAL(array_list_count(list, a), 10);
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(ArrayListAlgo_Count) {
+    array_list(uint16_t) list = array_list_new(uint16_t);
+
+    for (int i = 0; i < 1000; i++) {
+        uint16_t v = (uint16_t)(i % 7);
+        array_list_push_back(list, v);
+    }
+
+    for (uint16_t v = 0; v < 7; v++)
+        ASSERT_EQUAL(array_list_count(list, v), 1000 / 7 + (v < 1000 % 7));
+
+    uint16_t missing = 9;
+    ASSERT_EQUAL(array_list_count(list, missing), 0);
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(ArrayListAlgo_Sum) {
+    array_list(int32_t) ints = array_list_new(int32_t);
+    array_list(uint32_t) uints = array_list_new(uint32_t);
+    array_list(float) floats = array_list_new(float);
+    array_list(uint8_t) bytes = array_list_new(uint8_t);
+
+    for (int i = 0; i < 1001; i++) {
+        int32_t v = i % 2 ? -i : 2000000000;
+        uint32_t u = 4000000000u;
+        float f = 0.5f;
+        uint8_t b = 255;
+        array_list_push_back(ints, v);
+        array_list_push_back(uints, u);
+        array_list_push_back(floats, f);
+        array_list_push_back(bytes, b);
+    }
+
+    int64_t isum = 0;
+    for (int i = 0; i < 1001; i++)
+        isum += i % 2 ? -i : 2000000000;
+
+    int64_t got_i;
+    array_list_vsum(ints, ARRAY_LIST_I32, &got_i);
+    ASSERT_EQUAL(got_i, isum);
+
+    uint64_t got_u;
+    array_list_vsum(uints, ARRAY_LIST_U32, &got_u);
+    ASSERT_EQUAL(got_u, 1001ull * 4000000000ull);
+
+    double got_f;
+    array_list_vsum(floats, ARRAY_LIST_F32, &got_f);
+    ASSERT_TRUE(got_f == 500.5);
+
+    uint64_t got_b;
+    array_list_vsum(bytes, ARRAY_LIST_U8, &got_b);
+    ASSERT_EQUAL(got_b, 1001 * 255);
+
+    array_list_destroy((void *)ints);
+    array_list_destroy((void *)uints);
+    array_list_destroy((void *)floats);
+    array_list_destroy((void *)bytes);
+    return 0;
+}
+
+TEST_CASE(ArrayListAlgo_MinMax) {
+    array_list(int16_t) shorts = array_list_new(int16_t);
+    array_list(double) doubles = array_list_new(double);
+    array_list(uint64_t) longs = array_list_new(uint64_t);
+
+    int16_t lo, hi;
+    ASSERT_FALSE(array_list_vmin_max(shorts, ARRAY_LIST_I16, &lo, &hi));
+
+    for (int i = 0; i < 517; i++) {
+        int16_t s = (int16_t)((i * 37) % 517 - 200);
+        double d = (i * 13) % 517 * 0.25;
+        uint64_t l = (uint64_t)((i * 7) % 517) << 40;
+        array_list_push_back(shorts, s);
+        array_list_push_back(doubles, d);
+        array_list_push_back(longs, l);
+    }
+
+    ASSERT_TRUE(array_list_vmin_max(shorts, ARRAY_LIST_I16, &lo, &hi));
+    ASSERT_EQUAL(lo, -200);
+    ASSERT_EQUAL(hi, 316);
+
+    double dlo, dhi;
+    ASSERT_TRUE(array_list_vmin_max(doubles, ARRAY_LIST_F64, &dlo, &dhi));
+    ASSERT_TRUE(dlo == 0.0);
+    ASSERT_TRUE(dhi == 516 * 0.25);
+
+    uint64_t lhi;
+    ASSERT_TRUE(array_list_vmin_max(longs, ARRAY_LIST_U64, NULL, &lhi));
+    ASSERT_EQUAL(lhi, (uint64_t)516 << 40);
+
+    array_list_destroy((void *)shorts);
+    array_list_destroy((void *)doubles);
+    array_list_destroy((void *)longs);
+    return 0;
+}
+
+typedef struct {
+    int key;
+    int order;
+} keyed_t;
+
+static int cmp_keyed(const void *a, const void *b) {
+    const keyed_t *x = a, *y = b;
+    return (x->key > y->key) - (x->key < y->key);
+}
+
+static uint32_t next_random(uint32_t *state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+TEST_CASE(ArrayListAlgo_SortStable) {
+    array_list(keyed_t) list = array_list_new(keyed_t);
+
+    uint32_t seed = 1;
+    for (int i = 0; i < 5000; i++) {
+        keyed_t k = { (int)(next_random(&seed) % 100), i };
+        array_list_push_back(list, k);
+    }
+
+    array_list_sort(list, cmp_keyed);
+
+    for (size_t i = 1; i < array_list_size(list); i++) {
+        keyed_t prev = array_list_at(list, i - 1), curr = array_list_at(list, i);
+        ASSERT_TRUE(prev.key <= curr.key);
+        if (prev.key == curr.key)
+            ASSERT_TRUE(prev.order < curr.order);
+    }
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(ArrayListAlgo_SortParallel) {
+    size_t thread_counts[] = { 1, 2, 3, 4, 8, 0 };
+
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        array_list(keyed_t) list = array_list_new(keyed_t);
+
+        uint32_t seed = 7;
+        for (int i = 0; i < 100003; i++) {
+            keyed_t k = { (int)(next_random(&seed) % 1000), i };
+            array_list_push_back(list, k);
+        }
+
+        array_list_sort_parallel(list, cmp_keyed, thread_counts[t]);
+
+        ASSERT_EQUAL(array_list_size(list), 100003);
+        for (size_t i = 1; i < array_list_size(list); i++) {
+            keyed_t prev = array_list_at(list, i - 1), curr = array_list_at(list, i);
+            ASSERT_TRUE(prev.key <= curr.key);
+            if (prev.key == curr.key)
+                ASSERT_TRUE(prev.order < curr.order);
+        }
+
+        array_list_destroy((void *)list);
+    }
+    return 0;
+}
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static void *sort_parallel_repeatedly(void *arg) {
+    uint32_t seed = *(uint32_t *)arg;
+    for (int round = 0; round < 4; round++) {
+        array_list(int) list = array_list_new(int);
+        for (int i = 0; i < 50000; i++) {
+            int v = (int)(next_random(&seed) % 5000);
+            array_list_push_back(list, v);
+        }
+
+        array_list_sort_parallel(list, cmp_int, 4);
+
+        for (size_t i = 1; i < array_list_size(list); i++) {
+            if (array_list_at(list, i - 1) > array_list_at(list, i))
+                *(uint32_t *)arg = 0;
+        }
+        array_list_destroy((void *)list);
+    }
+    return NULL;
+}
+
+TEST_CASE(ArrayListAlgo_SortParallelConcurrent) {
+    // sorts racing for the shared workers must all come out sorted, whether they got the pool or not
+    pthread_t handles[3];
+    uint32_t seeds[3] = { 11, 12, 13 };
+    for (size_t i = 0; i < 3; i++)
+        pthread_create(&handles[i], NULL, sort_parallel_repeatedly, &seeds[i]);
+    for (size_t i = 0; i < 3; i++)
+        pthread_join(handles[i], NULL);
+
+    for (size_t i = 0; i < 3; i++)
+        ASSERT_NOTEQUAL(seeds[i], 0);
+    return 0;
+}
+
+TEST_CASE(ArrayListAlgo_SortParallelWideThenNarrow) {
+    // a wide sort spawns more workers than the narrow ones after it use, those must stay out of the narrow sorts
+    size_t sizes[] = { 100000, 20000 };
+    size_t threads[] = { 8, 2 };
+    uint32_t seed = 21;
+
+    for (int round = 0; round < 50; round++) {
+        size_t which = round == 0 ? 0 : 1;
+        array_list(int) list = array_list_new(int);
+        for (size_t i = 0; i < sizes[which]; i++) {
+            int v = (int)(next_random(&seed) % 10000);
+            array_list_push_back(list, v);
+        }
+
+        array_list_sort_parallel(list, cmp_int, threads[which]);
+
+        ASSERT_EQUAL(array_list_size(list), sizes[which]);
+        for (size_t i = 1; i < array_list_size(list); i++)
+            ASSERT_TRUE(array_list_at(list, i - 1) <= array_list_at(list, i));
+        array_list_destroy((void *)list);
+    }
+    return 0;
+}
+
+TEST_CASE(ArrayListAlgo_SortRadixInts) {
+    array_list(int32_t) ints = array_list_new(int32_t);
+    array_list(uint16_t) shorts = array_list_new(uint16_t);
+    array_list(int64_t) longs = array_list_new(int64_t);
+
+    uint32_t seed = 3;
+    for (int i = 0; i < 10000; i++) {
+        int32_t v = (int32_t)next_random(&seed) - (1 << 23);
+        uint16_t s = (uint16_t)next_random(&seed);
+        int64_t l = (int64_t)v * (1 << 20) - i;
+        array_list_push_back(ints, v);
+        array_list_push_back(shorts, s);
+        array_list_push_back(longs, l);
+    }
+
+    // a kind of the wrong size is turned down without touching the list
+    int32_t first = array_list_front(ints);
+    ASSERT_FALSE(array_list_sort_radix(ints, ARRAY_LIST_I64));
+    ASSERT_EQUAL(array_list_front(ints), first);
+
+    ASSERT_TRUE(array_list_sort_radix(ints, ARRAY_LIST_I32));
+    ASSERT_TRUE(array_list_sort_radix(shorts, ARRAY_LIST_U16));
+    ASSERT_TRUE(array_list_sort_radix(longs, ARRAY_LIST_I64));
+
+    for (size_t i = 1; i < 10000; i++) {
+        ASSERT_TRUE(array_list_at(ints, i - 1) <= array_list_at(ints, i));
+        ASSERT_TRUE(array_list_at(shorts, i - 1) <= array_list_at(shorts, i));
+        ASSERT_TRUE(array_list_at(longs, i - 1) <= array_list_at(longs, i));
+    }
+    ASSERT_TRUE(array_list_front(ints) < 0);
+
+    array_list_destroy((void *)ints);
+    array_list_destroy((void *)shorts);
+    array_list_destroy((void *)longs);
+    return 0;
+}
+
+TEST_CASE(ArrayListAlgo_SortRadixFloats) {
+    array_list(float) list = array_list_new(float);
+
+    float values[] = { 3.5f, -1.0f, 0.0f, -0.0f, 1e30f, -1e30f, 2.25f, -2.25f, 0.5f };
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+        array_list_push_back(list, values[i]);
+
+    array_list_sort_radix(list, ARRAY_LIST_F32);
+
+    float expected[] = { -1e30f, -2.25f, -1.0f, -0.0f, 0.0f, 0.5f, 2.25f, 3.5f, 1e30f };
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+        ASSERT_TRUE(array_list_at(list, i) == expected[i]);
+
+    array_list_destroy((void *)list);
+    return 0;
+}
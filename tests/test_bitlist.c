@@ -0,0 +1,118 @@
+#include <sncl_test.h>
+
+#include <sncl_bitlist.h>
+
+TEST_CASE(BitList_PushGetSet) {
+    bit_list bits = bit_list_create(1);
+
+    for (int i = 0; i < 1000; i++)
+        bit_list_push_back(bits, i % 3 == 0);
+
+    ASSERT_EQUAL(bit_list_size(bits), 1000);
+    ASSERT_EQUAL(bit_list_word_count(bits), 16);
+    for (int i = 0; i < 1000; i++)
+        ASSERT_EQUAL(bit_list_get(bits, i), i % 3 == 0);
+    ASSERT_EQUAL(bit_list_popcount(bits), 334);
+
+    bit_list_set(bits, 0, false);
+    bit_list_set(bits, 1, true);
+    bit_list_set(bits, 998, true);
+    ASSERT_FALSE(bit_list_get(bits, 0));
+    ASSERT_TRUE(bit_list_get(bits, 1));
+    ASSERT_TRUE(bit_list_get(bits, 998));
+    ASSERT_EQUAL(bit_list_popcount(bits), 335);
+
+    bit_list_destroy(bits);
+    return 0;
+}
+
+TEST_CASE(BitList_FindFirstSet) {
+    bit_list bits = bit_list_new();
+    bit_list_resize(bits, 500);
+
+    ASSERT_EQUAL(bit_list_find_first_set(bits, 0), 500);
+    bit_list_set(bits, 70, true);
+    bit_list_set(bits, 300, true);
+
+    ASSERT_EQUAL(bit_list_find_first_set(bits, 0), 70);
+    ASSERT_EQUAL(bit_list_find_first_set(bits, 70), 70);
+    ASSERT_EQUAL(bit_list_find_first_set(bits, 71), 300);
+    ASSERT_EQUAL(bit_list_find_first_set(bits, 301), 500);
+    ASSERT_EQUAL(bit_list_find_first_set(bits, 1000), 500);
+
+    bit_list_destroy(bits);
+    return 0;
+}
+
+TEST_CASE(BitList_Resize) {
+    bit_list bits = bit_list_new();
+    for (int i = 0; i < 100; i++)
+        bit_list_push_back(bits, true);
+
+    // shrinking clears what was cut off, so growing back only brings clear bits
+    bit_list_resize(bits, 10);
+    ASSERT_EQUAL(bit_list_popcount(bits), 10);
+    bit_list_resize(bits, 300);
+    ASSERT_EQUAL(bit_list_size(bits), 300);
+    ASSERT_EQUAL(bit_list_popcount(bits), 10);
+    ASSERT_EQUAL(bit_list_find_first_set(bits, 10), 300);
+
+    bit_list_reset(bits);
+    ASSERT_EQUAL(bit_list_popcount(bits), 0);
+    ASSERT_EQUAL(bit_list_size(bits), 300);
+
+    bit_list_destroy(bits);
+    return 0;
+}
+
+TEST_CASE(BitList_Bitwise) {
+    bit_list a = bit_list_new();
+    bit_list b = bit_list_new();
+    for (int i = 0; i < 200; i++) {
+        bit_list_push_back(a, i % 2 == 0);
+        bit_list_push_back(b, i % 3 == 0);
+    }
+
+    bit_list c = bit_list_new();
+    bit_list_resize(c, 200);
+    bit_list_or(c, a);
+    bit_list_and(c, b);
+    for (int i = 0; i < 200; i++)
+        ASSERT_EQUAL(bit_list_get(c, i), i % 6 == 0);
+
+    bit_list_xor(a, b);
+    for (int i = 0; i < 200; i++)
+        ASSERT_EQUAL(bit_list_get(a, i), (i % 2 == 0) != (i % 3 == 0));
+
+    // b | (a ^ b) == a | b, the multiples of 2 or 3
+    bit_list_or(b, a);
+    ASSERT_EQUAL(bit_list_popcount(b), 100 + 67 - 34);
+
+    bit_list_destroy(a);
+    bit_list_destroy(b);
+    bit_list_destroy(c);
+    return 0;
+}
+
+TEST_CASE(PackedList_Widths) {
+    for (unsigned width = 1; width <= 7; width++) {
+        packed_list list = packed_list_create(width, 1);
+        unsigned limit = 1u << width;
+
+        for (unsigned i = 0; i < 1000; i++)
+            packed_list_push_back(list, (i * 7) % limit);
+
+        ASSERT_EQUAL(packed_list_size(list), 1000);
+        ASSERT_EQUAL(packed_list_width(list), width);
+        for (unsigned i = 0; i < 1000; i++)
+            ASSERT_EQUAL(packed_list_get(list, i), (i * 7) % limit);
+
+        packed_list_set(list, 500, limit - 1);
+        ASSERT_EQUAL(packed_list_get(list, 499), (499 * 7) % limit);
+        ASSERT_EQUAL(packed_list_get(list, 500), limit - 1);
+        ASSERT_EQUAL(packed_list_get(list, 501), (501 * 7) % limit);
+
+        packed_list_destroy(list);
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <sncl_test.h>
+
+#include <sncl_columnlist.h>
+
+#include <stdint.h>
+
+typedef struct {
+    int id;
+    double price;
+    char tag;
+    short unused;
+} row_t;
+
+TEST_CASE(ColumnList_CreateEmpty) {
+    column_list(row_t) cl = column_list_new(row_t, COLUMN_LIST_FIELD(row_t, id), COLUMN_LIST_FIELD(row_t, price));
+
+    ASSERT_TRUE(column_list_empty(cl));
+    ASSERT_EQUAL(column_list_column_count(cl), 2);
+    ASSERT_EQUAL(column_list_capacity(cl), 16);
+
+    column_list_destroy(cl);
+    return 0;
+}
+
+TEST_CASE(ColumnList_PushGetRows) {
+    column_list(row_t) cl = column_list_new(row_t, COLUMN_LIST_FIELD(row_t, id), COLUMN_LIST_FIELD(row_t, price),
+                                            COLUMN_LIST_FIELD(row_t, tag));
+
+    for (int i = 0; i < 1000; i++) {
+        row_t r = { i, i * 1.5, (char)('a' + i % 26), 7 };
+        column_list_push_row(cl, r);
+    }
+    ASSERT_EQUAL(column_list_size(cl), 1000);
+
+    row_t r;
+    column_list_get_row(cl, 123, r);
+    ASSERT_EQUAL(r.id, 123);
+    ASSERT_TRUE(r.price == 123 * 1.5);
+    ASSERT_EQUAL(r.tag, 'a' + 123 % 26);
+    ASSERT_EQUAL(r.unused, 0); // not a column
+
+    row_t changed = { -1, -2.0, 'z', 0 };
+    column_list_set_row(cl, 10, changed);
+    column_list_get_row(cl, 10, r);
+    ASSERT_EQUAL(r.id, -1);
+    ASSERT_EQUAL(r.tag, 'z');
+
+    column_list_swap_remove(cl, 0);
+    ASSERT_EQUAL(column_list_size(cl), 999);
+    column_list_get_row(cl, 0, r);
+    ASSERT_EQUAL(r.id, 999);
+
+    column_list_destroy(cl);
+    return 0;
+}
+
+TEST_CASE(ColumnList_Columns) {
+    column_list(row_t) cl = column_list_new(row_t, COLUMN_LIST_FIELD(row_t, price), COLUMN_LIST_FIELD(row_t, id));
+    column_list_reserve(cl, 5000);
+    ASSERT_EQUAL(column_list_capacity(cl), 5000);
+
+    for (int i = 0; i < 5000; i++) {
+        row_t r = { i, 0.5, 0, 0 };
+        column_list_push_row(cl, r);
+    }
+    ASSERT_EQUAL(column_list_capacity(cl), 5000);
+
+    double *prices = column_list_column_as(cl, 0, double);
+    int *ids = column_list_column_as(cl, 1, int);
+    ASSERT_EQUAL((uintptr_t)prices % 64, 0);
+    ASSERT_EQUAL((uintptr_t)ids % 64, 0);
+
+    double total = 0;
+    long long id_total = 0;
+    for (size_t i = 0; i < column_list_size(cl); i++) {
+        total += prices[i];
+        id_total += ids[i];
+    }
+    ASSERT_TRUE(total == 2500.0);
+    ASSERT_EQUAL(id_total, 4999LL * 5000 / 2);
+
+    column_list_clear(cl);
+    ASSERT_TRUE(column_list_empty(cl));
+
+    column_list_destroy(cl);
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <sncl_test.h>
+
+#include <sncl_deque.h>
+
+TEST_CASE(Deque_CreateEmpty) {
+    deque(int) dq = deque_new(int);
+
+    ASSERT_TRUE(deque_empty(dq));
+    ASSERT_EQUAL(deque_size(dq), 0);
+    ASSERT_EQUAL(deque_capacity(dq), 16);
+    ASSERT_TRUE(deque__front(dq) == NULL);
+    ASSERT_TRUE(deque__back(dq) == NULL);
+
+    deque_destroy(dq);
+    return 0;
+}
+
+TEST_CASE(Deque_Fifo) {
+    deque(int) dq = deque__create(sizeof(int), 4);
+
+    for (int i = 0; i < 100000; i++)
+        deque_push_back(dq, i);
+    ASSERT_EQUAL(deque_size(dq), 100000);
+
+    for (int i = 0; i < 100000; i++) {
+        int v = deque_pop_front(dq);
+        ASSERT_EQUAL(v, i);
+    }
+    ASSERT_TRUE(deque_empty(dq));
+
+    deque_destroy(dq);
+    return 0;
+}
+
+TEST_CASE(Deque_BothEnds) {
+    deque(int) dq = deque__create(sizeof(int), 2);
+
+    // interleave so the ring wraps and grows while wrapped
+    for (int i = 1; i <= 50; i++) {
+        deque_push_back(dq, i);
+        int neg = -i;
+        deque_push_front(dq, neg);
+    }
+
+    ASSERT_EQUAL(deque_size(dq), 100);
+    ASSERT_EQUAL(deque_front(dq), -50);
+    ASSERT_EQUAL(deque_back(dq), 50);
+    for (int i = 0; i < 50; i++) {
+        ASSERT_EQUAL(deque_at(dq, i), i - 50);
+        ASSERT_EQUAL(deque_at(dq, 50 + i), i + 1);
+    }
+
+    int back = deque_pop_back(dq);
+    int front = deque_pop_front(dq);
+    ASSERT_EQUAL(back, 50);
+    ASSERT_EQUAL(front, -50);
+    ASSERT_EQUAL(deque_size(dq), 98);
+
+    deque_destroy(dq);
+    return 0;
+}
+
+TEST_CASE(Deque_Spans) {
+    deque(int) dq = deque__create(sizeof(int), 8);
+
+    void *first, *second;
+    size_t first_count, second_count;
+    deque_spans(dq, &first, &first_count, &second, &second_count);
+    ASSERT_TRUE(first == NULL && second == NULL);
+    ASSERT_EQUAL(first_count + second_count, 0);
+
+    for (int i = 0; i < 6; i++)
+        deque_push_back(dq, i);
+    deque_consume(dq, 5);
+    for (int i = 6; i < 12; i++)
+        deque_push_back(dq, i);
+
+    // elements 5..11 sit at ring slots 5..7 then 0..3
+    deque_spans(dq, &first, &first_count, &second, &second_count);
+    ASSERT_EQUAL(first_count, 3);
+    ASSERT_EQUAL(second_count, 4);
+
+    int expected = 5;
+    for (size_t i = 0; i < first_count; i++)
+        ASSERT_EQUAL(((int *)first)[i], expected++);
+    for (size_t i = 0; i < second_count; i++)
+        ASSERT_EQUAL(((int *)second)[i], expected++);
+
+    deque_consume(dq, 100);
+    ASSERT_TRUE(deque_empty(dq));
+
+    deque_destroy(dq);
+    return 0;
+}
+
+TEST_CASE(Deque_Reserve) {
+    deque(int) dq = deque__create(sizeof(int), 4);
+
+    for (int i = 0; i < 4; i++)
+        deque_push_front(dq, i);
+    deque_reserve(dq, 100);
+    ASSERT_EQUAL(deque_capacity(dq), 128);
+
+    for (int i = 0; i < 4; i++)
+        ASSERT_EQUAL(deque_at(dq, i), 3 - i);
+
+    deque_clear(dq);
+    ASSERT_TRUE(deque_empty(dq));
+    ASSERT_EQUAL(deque_capacity(dq), 128);
+
+    deque_destroy(dq);
+    return 0;
+}
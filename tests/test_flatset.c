@@ -0,0 +1,132 @@
+#include <sncl_test.h>
+
+#include <sncl_flatset.h>
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct {
+    int key;
+    double value;
+} entry_t;
+
+TEST_CASE(FlatSet_InsertKeepsOrder) {
+    flat_set(int) set = flat_set_new(int);
+
+    // 37 is coprime with 1000, so this visits every value once out of order
+    for (int i = 0; i < 1000; i++) {
+        int v = (i * 37) % 1000;
+        flat_set_insert(set, v, cmp_int);
+    }
+    int dup = 500;
+    bool inserted = true;
+    int *existing = flat_set__insert((void **)&set, &dup, cmp_int, &inserted);
+    ASSERT_FALSE(inserted);
+    ASSERT_EQUAL(*existing, 500);
+
+    ASSERT_EQUAL(array_list_size(set), 1000);
+    for (int i = 0; i < 1000; i++)
+        ASSERT_EQUAL(array_list_at(set, i), i);
+
+    flat_set_destroy(set);
+    return 0;
+}
+
+TEST_CASE(FlatSet_Bounds) {
+    flat_set(int) set = flat_set_new(int);
+    int values[] = { 10, 20, 20, 30 };
+    flat_set_insert_n(set, values, 4, cmp_int);
+
+    int probes[] = { 5, 10, 15, 20, 30, 35 };
+    size_t lower[] = { 0, 0, 1, 1, 2, 3 };
+    size_t upper[] = { 0, 1, 1, 2, 3, 3 };
+    for (size_t i = 0; i < 6; i++) {
+        ASSERT_EQUAL(flat_set_lower_bound(set, probes[i], cmp_int), lower[i]);
+        ASSERT_EQUAL(flat_set_upper_bound(set, probes[i], cmp_int), upper[i]);
+    }
+
+    int missing = 15, present = 30;
+    ASSERT_FALSE(flat_set_contains(set, missing, cmp_int));
+    ASSERT_EQUAL(*flat_set_find(set, present, cmp_int), 30);
+
+    flat_set_destroy(set);
+
+    flat_set(int) empty = flat_set_new(int);
+    ASSERT_EQUAL(flat_set_lower_bound(empty, present, cmp_int), 0);
+    ASSERT_TRUE(flat_set_find(empty, present, cmp_int) == NULL);
+    flat_set_destroy(empty);
+    return 0;
+}
+
+TEST_CASE(FlatSet_InsertBatch) {
+    flat_set(int) set = flat_set_new(int);
+    for (int i = 0; i < 100; i += 2)
+        flat_set_insert(set, i, cmp_int);
+
+    // odds to fill the gaps, some evens already present and a duplicate inside the batch
+    int batch[60];
+    for (int i = 0; i < 50; i++)
+        batch[i] = 99 - 2 * i;
+    for (int i = 50; i < 59; i++)
+        batch[i] = (i - 50) * 4;
+    batch[59] = 1;
+
+    ASSERT_EQUAL(flat_set_insert_n(set, batch, 60, cmp_int), 50);
+    ASSERT_EQUAL(array_list_size(set), 100);
+    for (int i = 0; i < 100; i++)
+        ASSERT_EQUAL(array_list_at(set, i), i);
+
+    int gone = 42;
+    ASSERT_TRUE(flat_set_erase(set, gone, cmp_int));
+    ASSERT_FALSE(flat_set_erase(set, gone, cmp_int));
+    ASSERT_EQUAL(array_list_size(set), 99);
+
+    flat_set_destroy(set);
+    return 0;
+}
+
+TEST_CASE(FlatSet_Build) {
+    array_list(int) list = array_list_new(int);
+    int values[] = { 5, 3, 5, 1, 3, 9 };
+    array_list_push_back_n(list, values, 6);
+
+    ASSERT_EQUAL(flat_set__build(list, cmp_int), 2);
+    int expected[] = { 1, 3, 5, 9 };
+    ASSERT_EQUAL(array_list_size(list), 4);
+    for (size_t i = 0; i < 4; i++)
+        ASSERT_EQUAL(array_list_at(list, i), expected[i]);
+
+    array_list_destroy((void *)list);
+    return 0;
+}
+
+TEST_CASE(FlatMap_PutGet) {
+    flat_map(entry_t) map = flat_map_new(entry_t);
+
+    for (int i = 0; i < 50; i++) {
+        entry_t e = { 49 - i, i * 0.5 };
+        flat_map_put(map, e, cmp_int);
+    }
+    entry_t replaced = { 10, -1.0 };
+    entry_t *stored = flat_map_put(map, replaced, cmp_int);
+    ASSERT_TRUE(stored->value == -1.0);
+    ASSERT_EQUAL(array_list_size(map), 50);
+
+    int key = 10;
+    ASSERT_TRUE(flat_map_get(map, key, cmp_int)->value == -1.0);
+    key = 0;
+    ASSERT_TRUE(flat_map_get(map, key, cmp_int)->value == 24.5);
+    key = 77;
+    ASSERT_TRUE(flat_map_get(map, key, cmp_int) == NULL);
+
+    // existing entries win over the batch
+    entry_t batch[] = { { 60, 1.0 }, { 0, 100.0 } };
+    ASSERT_EQUAL(flat_map_put_n(map, batch, 2, cmp_int), 1);
+    key = 0;
+    ASSERT_TRUE(flat_map_get(map, key, cmp_int)->value == 24.5);
+
+    flat_map_destroy(map);
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include <sncl_test.h>
+
+#include <sncl_hashmap.h>
+
+static uint64_t hash_int(const void *key) { return (uint64_t)*(const int *)key; }
+static bool eq_int(const void *a, const void *b) { return *(const int *)a == *(const int *)b; }
+
+TEST_CASE(HashMap_CreateEmpty) {
+    hash_map(int, double) map = hash_map_new(int, double, hash_int, eq_int);
+
+    ASSERT_TRUE(hash_map_empty(map));
+    ASSERT_EQUAL(hash_map_size(map), 0);
+    int key = 3;
+    ASSERT_TRUE(hash_map_get(map, key) == NULL);
+    ASSERT_FALSE(hash_map_erase(map, key));
+
+    hash_map_destroy(map);
+    return 0;
+}
+
+TEST_CASE(HashMap_PutGet) {
+    hash_map(int, double) map = hash_map_new(int, double, hash_int, eq_int);
+
+    for (int i = 0; i < 100000; i++) {
+        double v = i * 0.5;
+        hash_map_put(map, i, v);
+    }
+    ASSERT_EQUAL(hash_map_size(map), 100000);
+
+    for (int i = 0; i < 100000; i++) {
+        double *v = hash_map_get(map, i);
+        ASSERT_TRUE(v != NULL && *v == i * 0.5);
+    }
+
+    int key = 7;
+    double replaced = -1.0;
+    hash_map_put(map, key, replaced);
+    ASSERT_TRUE(*hash_map_get(map, key) == -1.0);
+    ASSERT_EQUAL(hash_map_size(map), 100000);
+
+    key = 100000;
+    ASSERT_FALSE(hash_map_contains(map, key));
+
+    hash_map_destroy(map);
+    return 0;
+}
+
+TEST_CASE(HashMap_EraseAndReinsert) {
+    hash_map(int, int) map = hash_map_new(int, int, NULL, NULL);
+
+    // churn through far more keys than the map ever holds at once, so erased slots must get reused or cleaned up
+    for (int round = 0; round < 50; round++) {
+        for (int i = 0; i < 1000; i++) {
+            int key = round * 1000 + i;
+            hash_map_put(map, key, i);
+        }
+        for (int i = 0; i < 1000; i++) {
+            int key = round * 1000 + i;
+            if (i % 10 != 0)
+                ASSERT_TRUE(hash_map_erase(map, key));
+        }
+    }
+
+    ASSERT_EQUAL(hash_map_size(map), 5000);
+    ASSERT_TRUE(hash_map_capacity(map) <= 16384);
+    for (int round = 0; round < 50; round++) {
+        for (int i = 0; i < 1000; i++) {
+            int key = round * 1000 + i;
+            ASSERT_EQUAL(hash_map_contains(map, key), i % 10 == 0);
+        }
+    }
+
+    hash_map_clear(map);
+    ASSERT_TRUE(hash_map_empty(map));
+    int key = 0;
+    ASSERT_FALSE(hash_map_contains(map, key));
+
+    hash_map_destroy(map);
+    return 0;
+}
+
+TEST_CASE(HashMap_StringKeys) {
+    hash_map(const char *, int) map = hash_map_new(const char *, int, hash_map_hash_str, hash_map_eq_str);
+
+    const char *words[] = { "alpha", "beta", "gamma", "delta" };
+    for (int i = 0; i < 4; i++)
+        hash_map_put(map, words[i], i);
+
+    // a different pointer to equal text finds the same entry
+    char buffer[] = "gamma";
+    const char *probe = buffer;
+    ASSERT_EQUAL(*hash_map_get(map, probe), 2);
+
+    *hash_map_emplace(map, probe) += 10;
+    ASSERT_EQUAL(*hash_map_get(map, words[2]), 12);
+    ASSERT_EQUAL(hash_map_size(map), 4);
+
+    hash_map_destroy(map);
+    return 0;
+}
+
+TEST_CASE(HashMap_ReserveAndLoad) {
+    hash_map(int, int) map = hash_map_new(int, int, hash_int, eq_int);
+
+    hash_map_reserve(map, 1000);
+    size_t cap = hash_map_capacity(map);
+    ASSERT_TRUE(cap * 7 / 8 >= 1000);
+    for (int i = 0; i < 1000; i++)
+        hash_map_put(map, i, i);
+    ASSERT_EQUAL(hash_map_capacity(map), cap);
+
+    hash_map_set_max_load(map, 0.5);
+    int key = 1000;
+    hash_map_put(map, key, key);
+    ASSERT_TRUE(hash_map_capacity(map) >= 2002);
+    ASSERT_EQUAL(hash_map_size(map), 1001);
+
+    hash_map_destroy(map);
+    return 0;
+}
+
+TEST_CASE(HashMap_LowerLoadWhenFull) {
+    // 896 entries fill 1024 slots at the default load, a single doubling to 2048 holds only 512 at 0.25
+    hash_map(int, int) map = hash_map_new(int, int, hash_int, eq_int);
+    for (int i = 0; i < 896; i++)
+        hash_map_put(map, i, i);
+
+    hash_map_set_max_load(map, 0.25);
+    ASSERT_TRUE(hash_map_capacity(map) / 4 > hash_map_size(map));
+
+    for (int i = 896; i < 3000; i++)
+        hash_map_put(map, i, i);
+    ASSERT_EQUAL(hash_map_size(map), 3000);
+    for (int i = 0; i < 3000; i++)
+        ASSERT_EQUAL(*hash_map_get(map, i), i);
+    int missing = -1;
+    ASSERT_FALSE(hash_map_contains(map, missing));
+
+    hash_map_destroy(map);
+    return 0;
+}
+
+TEST_CASE(HashMap_ZeroSizedValues) {
+    // a set, keys only
+    void *set = hash_map__create(sizeof(int), 0, sizeof(int), sizeof(int), hash_int, eq_int);
+    for (int i = 0; i < 100; i++)
+        hash_map__put(set, &i, &i);
+    ASSERT_EQUAL(hash_map_size(set), 100);
+    int key = 42;
+    ASSERT_TRUE(hash_map__get(set, &key) != NULL);
+
+    hash_map__destroy(set);
+    return 0;
+}
+
+TEST_CASE(HashMap_PutFromItself) {
+    hash_map(int, int) map = hash_map_new(int, int, hash_int, eq_int);
+
+    // every value is read straight out of the map, including across the puts that make it grow
+    int key = 0, value = 1000;
+    hash_map_put(map, key, value);
+    for (int i = 1; i < 5000; i++) {
+        int prev = i - 1;
+        hash_map__put(map, &i, hash_map__get(map, &prev));
+    }
+    for (int i = 0; i < 5000; i++)
+        ASSERT_EQUAL(*hash_map_get(map, i), 1000);
+
+    // and keys taken from values in the map, which point into its slots too
+    for (int i = 0; i < 5000; i++)
+        *hash_map_get(map, i) = i + 5000;
+    for (int i = 0; i < 5000; i++) {
+        bool inserted;
+        int *v = hash_map__emplace(map, hash_map__get(map, &i), &inserted);
+        ASSERT_TRUE(inserted);
+        *v = -i;
+    }
+    ASSERT_EQUAL(hash_map_size(map), 10000);
+    for (int i = 0; i < 5000; i++) {
+        int moved = i + 5000;
+        ASSERT_EQUAL(*hash_map_get(map, moved), -i);
+    }
+
+    hash_map_destroy(map);
+    return 0;
+}
+
+TEST_CASE(HashMap_Iterate) {
+    hash_map(int, int) map = hash_map_new(int, int, hash_int, eq_int);
+    for (int i = 0; i < 300; i++) {
+        int sq = i * i;
+        hash_map_put(map, i, sq);
+    }
+
+    size_t cursor = 0, seen = 0;
+    void *key, *value;
+    long long sum = 0;
+    while (hash_map__next(map, &cursor, &key, &value)) {
+        ASSERT_EQUAL(*(int *)value, *(int *)key * *(int *)key);
+        sum += *(int *)key;
+        seen++;
+    }
+    ASSERT_EQUAL(seen, 300);
+    ASSERT_EQUAL(sum, 299 * 300 / 2);
+
+    hash_map_destroy(map);
+    return 0;
+}
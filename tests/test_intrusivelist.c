@@ -0,0 +1,126 @@
+#include <sncl_test.h>
+
+#include <sncl_intrusivelist.h>
+
+typedef struct {
+    int id;
+    intrusive_link_t by_age;
+    char payload[200];
+    intrusive_link_t by_size;
+} object_t;
+
+TEST_CASE(IntrusiveList_CreateEmpty) {
+    intrusive_list_t list;
+    intrusive_list_init(&list);
+
+    ASSERT_TRUE(intrusive_list_empty(&list));
+    ASSERT_EQUAL(intrusive_list_size(&list), 0);
+    ASSERT_TRUE(intrusive_list_first(&list) == NULL);
+    ASSERT_TRUE(intrusive_list_last(&list) == NULL);
+    ASSERT_TRUE(intrusive_list_pop_front(&list) == NULL);
+    ASSERT_TRUE(intrusive_list_pop_back(&list) == NULL);
+    return 0;
+}
+
+TEST_CASE(IntrusiveList_LinksInPlace) {
+    intrusive_list_t list;
+    intrusive_list_init(&list);
+    object_t objects[5];
+
+    for (int i = 0; i < 5; i++) {
+        objects[i].id = i;
+        intrusive_list_push_back(&list, &objects[i].by_age);
+    }
+
+    ASSERT_EQUAL(intrusive_list_size(&list), 5);
+    ASSERT_TRUE(intrusive_list_front(&list, object_t, by_age) == &objects[0]);
+    ASSERT_TRUE(intrusive_list_back(&list, object_t, by_age) == &objects[4]);
+
+    int expected = 0;
+    intrusive_list_for_each(&list, it) {
+        object_t *o = intrusive_list_entry(it, object_t, by_age);
+        ASSERT_TRUE(o == &objects[expected]);
+        expected++;
+    }
+    ASSERT_EQUAL(expected, 5);
+
+    for (intrusive_link_t *it = intrusive_list_last(&list); it; it = intrusive_list_prev(&list, it)) {
+        expected--;
+        ASSERT_EQUAL(intrusive_list_entry(it, object_t, by_age)->id, expected);
+    }
+    return 0;
+}
+
+TEST_CASE(IntrusiveList_SeveralListsAtOnce) {
+    intrusive_list_t by_age, by_size;
+    intrusive_list_init(&by_age);
+    intrusive_list_init(&by_size);
+    object_t objects[4];
+
+    for (int i = 0; i < 4; i++) {
+        objects[i].id = i;
+        intrusive_link_init(&objects[i].by_age);
+        intrusive_link_init(&objects[i].by_size);
+        intrusive_list_push_back(&by_age, &objects[i].by_age);
+        intrusive_list_push_front(&by_size, &objects[i].by_size);
+    }
+
+    // dropping an object from one list leaves it on the other
+    intrusive_list_remove(&by_age, &objects[2].by_age);
+    ASSERT_FALSE(intrusive_link_is_linked(&objects[2].by_age));
+    ASSERT_TRUE(intrusive_link_is_linked(&objects[2].by_size));
+    ASSERT_EQUAL(intrusive_list_size(&by_age), 3);
+    ASSERT_EQUAL(intrusive_list_size(&by_size), 4);
+
+    int age_order[] = { 0, 1, 3 };
+    int i = 0;
+    intrusive_list_for_each(&by_age, it) {
+        ASSERT_EQUAL(intrusive_list_entry(it, object_t, by_age)->id, age_order[i]);
+        i++;
+    }
+
+    int size_order[] = { 3, 2, 1, 0 };
+    i = 0;
+    intrusive_list_for_each(&by_size, it) {
+        ASSERT_EQUAL(intrusive_list_entry(it, object_t, by_size)->id, size_order[i]);
+        i++;
+    }
+
+    intrusive_list_clear(&by_size);
+    ASSERT_TRUE(intrusive_list_empty(&by_size));
+    ASSERT_FALSE(intrusive_link_is_linked(&objects[0].by_size));
+    ASSERT_TRUE(intrusive_link_is_linked(&objects[0].by_age));
+    return 0;
+}
+
+TEST_CASE(IntrusiveList_InsertAndRemove) {
+    intrusive_list_t list;
+    intrusive_list_init(&list);
+    object_t objects[6];
+    for (int i = 0; i < 6; i++)
+        objects[i].id = i;
+
+    intrusive_list_push_back(&list, &objects[1].by_age);
+    intrusive_list_push_back(&list, &objects[4].by_age);
+    intrusive_list_insert_before(&list, &objects[1].by_age, &objects[0].by_age);
+    intrusive_list_insert_after(&list, &objects[1].by_age, &objects[3].by_age);
+    intrusive_list_insert_before(&list, &objects[3].by_age, &objects[2].by_age);
+    intrusive_list_insert_after(&list, &objects[4].by_age, &objects[5].by_age);
+
+    // remove every odd object while iterating
+    int i = 0;
+    intrusive_list_for_each_safe(&list, it, tmp) {
+        object_t *o = intrusive_list_entry(it, object_t, by_age);
+        ASSERT_EQUAL(o->id, i);
+        if (o->id % 2)
+            intrusive_list_remove(&list, it);
+        i++;
+    }
+
+    ASSERT_EQUAL(intrusive_list_size(&list), 3);
+    ASSERT_TRUE(intrusive_list_entry(intrusive_list_pop_front(&list), object_t, by_age) == &objects[0]);
+    ASSERT_TRUE(intrusive_list_entry(intrusive_list_pop_back(&list), object_t, by_age) == &objects[4]);
+    ASSERT_TRUE(intrusive_list_pop_front(&list) == &objects[2].by_age);
+    ASSERT_TRUE(intrusive_list_empty(&list));
+    return 0;
+}
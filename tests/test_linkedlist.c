@@ -2,6 +2,9 @@
 
 #include <sncl_linkedlist.h>
 
+#include <pthread.h>
+#include <stdint.h>
+
 TEST_CASE(LinkedList_CreateEmpty) {
     linked_list(int) list = linked_list_new(int);
 
@@ -181,3 +184,337 @@ TEST_CASE(LinkedList_Clear) {
     linked_list_destroy(list);
     return 0;
 }
+
+TEST_CASE(LinkedList_Pooled) {
+    linked_list(double) list = linked_list_new_pooled(double, 8);
+    ASSERT_TRUE(linked_list_is_pooled(list));
+
+    for (int i = 0; i < 100; ++i) {
+        double v = i * 0.5;
+        linked_list_push_back(list, v);
+    }
+    ASSERT_EQUAL(linked_list_size(list), 100);
+    ASSERT_TRUE(linked_list_at(list, 99) == 49.5);
+
+    // nodes from the same slab sit next to each other, aligned for the element type
+    double *first = (double *)linked_list__front(list);
+    double *second = (double *)linked_list__get(list, 1);
+    ASSERT_EQUAL((uintptr_t)first % sizeof(double), 0);
+    ASSERT_TRUE((char *)second > (char *)first && (char *)second - (char *)first < 64);
+
+    // removed nodes are handed out again before anything new
+    double *back = (double *)linked_list__back(list);
+    double popped = linked_list_pop_back(list);
+    ASSERT_TRUE(popped == 49.5);
+    double v = -1.0;
+    linked_list_push_front(list, v);
+    ASSERT_TRUE((double *)linked_list__front(list) == back);
+
+    for (int i = 0; i < 50; ++i)
+        linked_list__remove(list, 1);
+    ASSERT_EQUAL(linked_list_size(list), 50);
+
+    linked_list_clear(list);
+    ASSERT_TRUE(linked_list_empty(list));
+    for (int i = 0; i < 1000; ++i) {
+        double w = i;
+        linked_list_push_back(list, w);
+    }
+    ASSERT_TRUE(linked_list_back(list) == 999.0);
+    ASSERT_EQUAL(linked_list_size(list), 1000);
+
+    linked_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(LinkedList_FingerAccess) {
+    linked_list(int) list = linked_list_new(int);
+
+    for (int i = 0; i < 1000; i++)
+        linked_list_push_back(list, i);
+
+    // forwards, backwards and from the tail end, each step starting from the finger
+    for (int i = 0; i < 1000; i++)
+        ASSERT_EQUALFMT(linked_list_at(list, i), i, "%d != %d");
+    for (int i = 999; i >= 0; i--)
+        ASSERT_EQUALFMT(linked_list_at(list, i), i, "%d != %d");
+
+    // inserting and removing around the finger keeps it pointing at the right index
+    int v = -1;
+    ASSERT_EQUALFMT(linked_list_at(list, 500), 500, "%d != %d");
+    linked_list_add(list, 250, v);
+    ASSERT_EQUALFMT(linked_list_at(list, 501), 500, "%d != %d");
+    linked_list_push_front(list, v);
+    ASSERT_EQUALFMT(linked_list_at(list, 502), 500, "%d != %d");
+    linked_list__remove(list, 251);
+    linked_list__pop_front(list);
+    ASSERT_EQUALFMT(linked_list_at(list, 500), 500, "%d != %d");
+    linked_list__remove(list, 500);
+    ASSERT_EQUALFMT(linked_list_at(list, 500), 501, "%d != %d");
+    ASSERT_EQUALFMT(linked_list_at(list, 499), 499, "%d != %d");
+
+    linked_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(LinkedList_StrideIndex) {
+    linked_list(int) list = linked_list_new(int);
+    linked_list_set_index_stride(list, 16);
+
+    int reference[2000];
+    int size = 0;
+    for (int i = 0; i < 1000; i++) {
+        linked_list_push_back(list, i);
+        reference[size++] = i;
+    }
+
+    uint32_t seed = 5;
+    for (int step = 0; step < 4000; step++) {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t r = seed >> 8;
+        int pos = (int)((r >> 4) % (uint32_t)size);
+
+        switch (r % 8) {
+        case 0:
+            linked_list_add(list, pos, step);
+            memmove(&reference[pos + 1], &reference[pos], (size_t)(size - pos) * sizeof(int));
+            reference[pos] = step;
+            size++;
+            break;
+        case 1:
+            linked_list__remove(list, pos);
+            memmove(&reference[pos], &reference[pos + 1], (size_t)(size - pos - 1) * sizeof(int));
+            size--;
+            break;
+        case 2:
+            linked_list_push_back(list, step);
+            reference[size++] = step;
+            break;
+        case 3:
+            linked_list__pop_back(list);
+            size--;
+            break;
+        default:
+            ASSERT_EQUALFMT(linked_list_at(list, pos), reference[pos], "%d != %d");
+            break;
+        }
+    }
+
+    ASSERT_EQUAL(linked_list_size(list), (size_t)size);
+    for (int i = 0; i < size; i++)
+        ASSERT_EQUALFMT(linked_list_at(list, i), reference[i], "%d != %d");
+
+    linked_list_set_index_stride(list, 0);
+    ASSERT_EQUALFMT(linked_list_at(list, size / 2), reference[size / 2], "%d != %d");
+
+    linked_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(LinkedList_ExternalIterators) {
+    linked_list(int) list = linked_list_new(int);
+
+    for (int i = 0; i < 10; i++)
+        linked_list_push_back(list, i);
+
+    // two independent traversals at once
+    linked_list_iter_t fwd = linked_list_iter_begin(list), rev = linked_list_iter_rbegin(list);
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQUALFMT(*linked_list_iter_at(list, &fwd), i, "%d != %d");
+        ASSERT_EQUALFMT(*linked_list_iter_at(list, &rev), 9 - i, "%d != %d");
+        linked_list_iter_next(&fwd);
+        linked_list_iter_next(&rev);
+    }
+    ASSERT_TRUE(linked_list_iter_get(&fwd) == NULL);
+    ASSERT_TRUE(linked_list_iter_get(&rev) == NULL);
+
+    // drop the odd elements and put a negated copy before each even one
+    for (linked_list_iter_t it = linked_list_iter_begin(list); linked_list_iter_get(&it);) {
+        int v = *linked_list_iter_at(list, &it);
+        if (v % 2) {
+            linked_list_iter_remove(&it);
+        } else {
+            int neg = -v - 1;
+            linked_list_iter_insert(&it, neg);
+            linked_list_iter_next(&it);
+        }
+    }
+
+    int expected[] = { -1, 0, -3, 2, -5, 4, -7, 6, -9, 8 };
+    ASSERT_EQUAL(linked_list_size(list), 10);
+    for (int i = 0; i < 10; i++)
+        ASSERT_EQUALFMT(linked_list_at(list, i), expected[i], "%d != %d");
+
+    // stepping back against a reverse iterator, and removing through it
+    linked_list_iter_t it = linked_list_iter_rbegin(list);
+    linked_list_iter_next(&it);
+    linked_list_iter_prev(&it);
+    ASSERT_EQUALFMT(*linked_list_iter_at(list, &it), 8, "%d != %d");
+    linked_list_iter_remove(&it);
+    ASSERT_EQUALFMT(*linked_list_iter_at(list, &it), -9, "%d != %d");
+    ASSERT_EQUALFMT(linked_list_back(list), -9, "%d != %d");
+
+    // inserting past the end appends
+    it = linked_list_iter_begin(list);
+    for (int i = 0; i < 9; i++)
+        linked_list_iter_next(&it);
+    int last = 100;
+    linked_list_iter_insert(&it, last);
+    ASSERT_EQUALFMT(linked_list_back(list), 100, "%d != %d");
+    ASSERT_EQUAL(linked_list_size(list), 10);
+
+    linked_list_destroy(list);
+    return 0;
+}
+
+static void double_in_place(void *elem, __attribute__((unused)) void *ctx) { *(int64_t *)elem *= 2; }
+
+TEST_CASE(LinkedList_ForEachRange) {
+    linked_list(int64_t) list = linked_list_new_pooled(int64_t, 1024);
+
+    for (int64_t i = 0; i < 50000; i++)
+        linked_list_push_back(list, i);
+
+    // threaded, threaded through an index, and a short range that stays on the calling thread
+    linked_list_for_each_range(list, 0, 50000, double_in_place, NULL, 4);
+    linked_list_set_index_stride(list, 256);
+    linked_list_for_each_range(list, 1000, 49000, double_in_place, NULL, 3);
+    linked_list_for_each_range(list, 10, 20, double_in_place, NULL, 0);
+    linked_list_for_each_range(list, 40000, 100000, double_in_place, NULL, 1);
+
+    int64_t i = 0;
+    for (linked_list_iter_t it = linked_list_iter_begin(list); linked_list_iter_get(&it); linked_list_iter_next(&it)) {
+        int64_t factor = 2;
+        if (i >= 1000 && i < 49000)
+            factor *= 2;
+        if (i >= 10 && i < 20)
+            factor *= 2;
+        if (i >= 40000)
+            factor *= 2;
+        ASSERT_EQUAL(*linked_list_iter_at(list, &it), i * factor);
+        i++;
+    }
+    ASSERT_EQUAL(i, 50000);
+
+    linked_list_destroy(list);
+    return 0;
+}
+
+static void sum_into(void *elem, void *ctx) { __atomic_fetch_add((int64_t *)ctx, *(int64_t *)elem, __ATOMIC_RELAXED); }
+
+typedef struct {
+    int64_t *list;
+    int64_t sum;
+} range_reader_t;
+
+static void *sum_range_repeatedly(void *arg) {
+    range_reader_t *r = arg;
+    for (int round = 0; round < 20; round++)
+        linked_list_for_each_range(r->list, 100, 40100, sum_into, &r->sum, 4);
+    return NULL;
+}
+
+TEST_CASE(LinkedList_ForEachRangeConcurrentReaders) {
+    linked_list(int64_t) list = linked_list_new(int64_t);
+    for (int64_t i = 0; i < 50000; i++)
+        linked_list_push_back(list, i);
+
+    // a stale index is one `linked_list__get` would rebuild, readers walking ranges must leave it be
+    linked_list_set_index_stride(list, 256);
+    int64_t v = -1;
+    linked_list_add(list, 10, v);
+    linked_list__remove(list, 10);
+
+    pthread_t handles[2];
+    range_reader_t readers[2] = { { list, 0 }, { list, 0 } };
+    for (size_t i = 0; i < 2; i++)
+        pthread_create(&handles[i], NULL, sum_range_repeatedly, &readers[i]);
+    for (size_t i = 0; i < 2; i++)
+        pthread_join(handles[i], NULL);
+
+    int64_t expected = 20 * (int64_t)(100 + 40099) * 40000 / 2;
+    ASSERT_EQUAL(readers[0].sum, expected);
+    ASSERT_EQUAL(readers[1].sum, expected);
+
+    linked_list_destroy(list);
+    return 0;
+}
+
+static int check_contents(int *list, const int *expected, size_t count) {
+    ASSERT_EQUAL(linked_list_size(list), count);
+    size_t i = 0;
+    for (linked_list_iter_t it = linked_list_iter_begin(list); linked_list_iter_get(&it); linked_list_iter_next(&it)) {
+        ASSERT_EQUALFMT(*linked_list_iter_at(list, &it), expected[i], "%d != %d");
+        i++;
+    }
+    // walking back checks the prev links too
+    for (linked_list_iter_t it = linked_list_iter_rbegin(list); linked_list_iter_get(&it); linked_list_iter_next(&it)) {
+        i--;
+        ASSERT_EQUALFMT(*linked_list_iter_at(list, &it), expected[i], "%d != %d");
+    }
+    return 0;
+}
+
+static int splice_between(int *a, int *b) {
+    for (int i = 0; i < 4; i++)
+        linked_list_push_back(a, i);
+    for (int i = 10; i < 13; i++)
+        linked_list_push_back(b, i);
+
+    linked_list_splice(a, 2, b);
+    int spliced[] = { 0, 1, 10, 11, 12, 2, 3 };
+    ASSERT_EQUAL(check_contents(a, spliced, 7), 0);
+    ASSERT_TRUE(linked_list_empty(b));
+
+    int *tail = linked_list_split_at(a, 4);
+    int head_part[] = { 0, 1, 10, 11 }, tail_part[] = { 12, 2, 3 };
+    ASSERT_EQUAL(check_contents(a, head_part, 4), 0);
+    ASSERT_EQUAL(check_contents(tail, tail_part, 3), 0);
+    ASSERT_EQUAL(linked_list_is_pooled(tail), linked_list_is_pooled(a));
+
+    linked_list_concat(b, tail);
+    linked_list_concat(b, a);
+    int joined[] = { 12, 2, 3, 0, 1, 10, 11 };
+    ASSERT_EQUAL(check_contents(b, joined, 7), 0);
+    ASSERT_TRUE(linked_list_empty(a));
+    ASSERT_TRUE(linked_list_empty(tail));
+
+    // moving a range from the middle, from the front and from the back
+    linked_list_move_range(a, 0, b, 2, 5);
+    int moved[] = { 3, 0, 1 }, left[] = { 12, 2, 10, 11 };
+    ASSERT_EQUAL(check_contents(a, moved, 3), 0);
+    ASSERT_EQUAL(check_contents(b, left, 4), 0);
+
+    linked_list_move_range(a, 1, b, 0, 1);
+    linked_list_move_range(a, 4, b, 2, 3);
+    int moved_more[] = { 3, 12, 0, 1, 11 }, left_more[] = { 2, 10 };
+    ASSERT_EQUAL(check_contents(a, moved_more, 5), 0);
+    ASSERT_EQUAL(check_contents(b, left_more, 2), 0);
+
+    // both ends still work for plain pushes and pops afterwards
+    int v = 99;
+    linked_list_push_back(b, v);
+    linked_list_push_front(a, v);
+    ASSERT_EQUALFMT(linked_list_back(b), 99, "%d != %d");
+    ASSERT_EQUALFMT(linked_list_at(a, 5), 11, "%d != %d");
+    ASSERT_TRUE(linked_list_split_at(a, 7) == NULL);
+
+    linked_list_destroy(tail);
+    return 0;
+}
+
+TEST_CASE(LinkedList_SpliceSplitMove) {
+    linked_list(int) a = linked_list_new(int);
+    linked_list(int) b = linked_list_new(int);
+    ASSERT_EQUAL(splice_between(a, b), 0);
+    linked_list_destroy(a);
+    linked_list_destroy(b);
+
+    // pooled lists copy instead of relinking, with the same results
+    a = linked_list_new_pooled(int, 4);
+    b = linked_list_new(int);
+    ASSERT_EQUAL(splice_between(a, b), 0);
+    linked_list_destroy(a);
+    linked_list_destroy(b);
+    return 0;
+}
@@ -0,0 +1,175 @@
+// clock_gettime and nanosleep are POSIX, which a strict C99 build hides otherwise
+#if !defined(_POSIX_C_SOURCE) && defined(__unix__)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <sncl_test.h>
+
+#include <sncl_mpmcqueue.h>
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+TEST_CASE(MpmcQueue_SingleThreadOrder) {
+    mpmc_queue(int) q = mpmc_queue_new(int, 1);
+    mpmc_queue_handle_t *h = mpmc_queue_attach(q);
+    ASSERT_TRUE(h != NULL);
+
+    int out = -1;
+    ASSERT_TRUE(mpmc_queue_empty(q, h));
+    ASSERT_FALSE(mpmc_queue_pop(q, h, out));
+    ASSERT_EQUALFMT(out, -1, "%d != %d");
+
+    // enough rounds to go through the retire scans and node caches many times over
+    for (int round = 0; round < 50; round++) {
+        for (int i = 0; i < 300; i++)
+            mpmc_queue_push(q, h, i);
+        ASSERT_FALSE(mpmc_queue_empty(q, h));
+        for (int i = 0; i < 300; i++) {
+            ASSERT_TRUE(mpmc_queue_pop(q, h, out));
+            ASSERT_EQUALFMT(out, i, "%d != %d");
+        }
+        ASSERT_FALSE(mpmc_queue_pop(q, h, out));
+    }
+
+    mpmc_queue_detach(q, h);
+    mpmc_queue_destroy(q);
+    return 0;
+}
+
+TEST_CASE(MpmcQueue_AttachLimit) {
+    mpmc_queue(int) q = mpmc_queue_new(int, 2);
+
+    mpmc_queue_handle_t *a = mpmc_queue_attach(q);
+    mpmc_queue_handle_t *b = mpmc_queue_attach(q);
+    ASSERT_TRUE(a != NULL && b != NULL && a != b);
+    ASSERT_TRUE(mpmc_queue_attach(q) == NULL);
+
+    // values pushed through one handle come out through another
+    int v = 5, out = 0;
+    mpmc_queue_push(q, a, v);
+    mpmc_queue_detach(q, a);
+    ASSERT_TRUE(mpmc_queue_pop(q, b, out));
+    ASSERT_EQUALFMT(out, 5, "%d != %d");
+
+    ASSERT_TRUE(mpmc_queue_attach(q) == a);
+
+    mpmc_queue_destroy(q);
+    return 0;
+}
+
+#define PRODUCERS 3
+#define CONSUMERS 3
+#define PER_PRODUCER 20000
+
+typedef struct {
+    uint64_t *q;
+    int id;
+    uint64_t *received; // consumers only, everything they popped in order
+    size_t received_count;
+    size_t *total;
+} worker_t;
+
+static void *producer(void *arg) {
+    worker_t *w = arg;
+    mpmc_queue_handle_t *h = mpmc_queue_attach(w->q);
+    for (uint64_t i = 0; i < PER_PRODUCER; i++) {
+        uint64_t v = (uint64_t)w->id << 32 | i;
+        mpmc_queue_push(w->q, h, v);
+    }
+    mpmc_queue_detach(w->q, h);
+    return NULL;
+}
+
+static void *consumer(void *arg) {
+    worker_t *w = arg;
+    mpmc_queue_handle_t *h = mpmc_queue_attach(w->q);
+    while (__atomic_load_n(w->total, __ATOMIC_RELAXED) < PRODUCERS * PER_PRODUCER) {
+        uint64_t v;
+        if (mpmc_queue_pop_wait(w->q, h, v, 10)) {
+            w->received[w->received_count++] = v;
+            __atomic_fetch_add(w->total, 1, __ATOMIC_RELAXED);
+        }
+    }
+    mpmc_queue_detach(w->q, h);
+    return NULL;
+}
+
+TEST_CASE(MpmcQueue_ProducersConsumers) {
+    mpmc_queue(uint64_t) q = mpmc_queue_new(uint64_t, PRODUCERS + CONSUMERS);
+    pthread_t threads[PRODUCERS + CONSUMERS];
+    worker_t workers[PRODUCERS + CONSUMERS];
+    size_t total = 0;
+
+    for (int i = 0; i < PRODUCERS + CONSUMERS; i++) {
+        bool is_consumer = i >= PRODUCERS;
+        workers[i] = (worker_t){ q, i, NULL, 0, &total };
+        if (is_consumer)
+            workers[i].received = malloc(PRODUCERS * PER_PRODUCER * sizeof(uint64_t));
+        pthread_create(&threads[i], NULL, is_consumer ? consumer : producer, &workers[i]);
+    }
+    for (int i = 0; i < PRODUCERS + CONSUMERS; i++)
+        pthread_join(threads[i], NULL);
+
+    // every value arrives exactly once, and each consumer sees each producer's values in order
+    unsigned char *seen = calloc(PRODUCERS * PER_PRODUCER, 1);
+    size_t count = 0;
+    for (int c = PRODUCERS; c < PRODUCERS + CONSUMERS; c++) {
+        int64_t last[PRODUCERS] = { -1, -1, -1 };
+        for (size_t i = 0; i < workers[c].received_count; i++) {
+            uint64_t v = workers[c].received[i];
+            int p = (int)(v >> 32);
+            int64_t seq = (int64_t)(v & 0xFFFFFFFF);
+            ASSERT_TRUE(p < PRODUCERS && seq < PER_PRODUCER);
+            ASSERT_TRUE(seq > last[p]);
+            last[p] = seq;
+            ASSERT_FALSE(seen[p * PER_PRODUCER + seq]);
+            seen[p * PER_PRODUCER + seq] = 1;
+            count++;
+        }
+        free(workers[c].received);
+    }
+    ASSERT_EQUAL(count, PRODUCERS * PER_PRODUCER);
+    free(seen);
+
+    mpmc_queue_destroy(q);
+    return 0;
+}
+
+static void *delayed_push(void *arg) {
+    int *q = arg;
+    mpmc_queue_handle_t *h = mpmc_queue_attach(q);
+    struct timespec nap = { 0, 20000000L };
+    nanosleep(&nap, NULL);
+    int v = 42;
+    mpmc_queue_push(q, h, v);
+    mpmc_queue_detach(q, h);
+    return NULL;
+}
+
+TEST_CASE(MpmcQueue_PopWait) {
+    mpmc_queue(int) q = mpmc_queue_new(int, 2);
+    mpmc_queue_handle_t *h = mpmc_queue_attach(q);
+    int out = 0;
+
+    // times out on an empty queue
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ASSERT_FALSE(mpmc_queue_pop_wait(q, h, out, 30));
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    long waited_ms = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000;
+    ASSERT_TRUE(waited_ms >= 29);
+
+    // wakes up once another thread pushes
+    pthread_t thread;
+    pthread_create(&thread, NULL, delayed_push, q);
+    ASSERT_TRUE(mpmc_queue_pop_wait(q, h, out, MPMC_QUEUE_WAIT_FOREVER));
+    ASSERT_EQUALFMT(out, 42, "%d != %d");
+    pthread_join(thread, NULL);
+
+    mpmc_queue_detach(q, h);
+    mpmc_queue_destroy(q);
+    return 0;
+}
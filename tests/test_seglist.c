@@ -0,0 +1,174 @@
+#include <sncl_test.h>
+
+#include <sncl_seglist.h>
+
+#include <pthread.h>
+#include <sched.h>
+
+TEST_CASE(SegList_CreateEmpty) {
+    seg_list(int) list = seg_list_new(int);
+
+    ASSERT_TRUE(seg_list_empty(list));
+    ASSERT_EQUAL(seg_list_size(list), 0);
+    ASSERT_EQUAL(seg_list_capacity(list), 0);
+    ASSERT_EQUAL(seg_list_segment_count(list), 0);
+
+    seg_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(SegList_PushBackAndIndex) {
+    seg_list(int) list = seg_list_new(int);
+
+    for (int i = 0; i < 100000; i++)
+        seg_list_push_back(list, i);
+
+    ASSERT_EQUAL(seg_list_size(list), 100000);
+    ASSERT_EQUALFMT(seg_list_front(list), 0, "%d != %d");
+    ASSERT_EQUALFMT(seg_list_back(list), 99999, "%d != %d");
+    for (int i = 0; i < 100000; i++)
+        ASSERT_EQUAL(seg_list_at(list, i), i);
+
+    seg_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(SegList_StablePointers) {
+    seg_list(int) list = seg_list__create(sizeof(int), 4);
+
+    int first = 42;
+    int *p = seg_list_push_back(list, first);
+    for (int i = 0; i < 10000; i++)
+        seg_list_push_back(list, i);
+
+    ASSERT_TRUE(p == &seg_list_at(list, 0));
+    ASSERT_EQUAL(*p, 42);
+
+    seg_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(SegList_Segments) {
+    seg_list(int) list = seg_list__create(sizeof(int), 3);
+
+    for (int i = 0; i < 20; i++)
+        seg_list_push_back(list, i);
+
+    // segments of 4, 8 and 16 elements
+    ASSERT_EQUAL(seg_list_segment_count(list), 3);
+    ASSERT_EQUAL(seg_list_capacity(list), 28);
+
+    int expected = 0;
+    for (size_t k = 0; k < seg_list_segment_count(list); k++) {
+        size_t count;
+        int *run = seg_list_segment(list, k, &count);
+        for (size_t i = 0; i < count; i++)
+            ASSERT_EQUAL(run[i], expected++);
+    }
+    ASSERT_EQUAL(expected, 20);
+
+    seg_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(SegList_PopAndClear) {
+    seg_list(int) list = seg_list_new(int);
+
+    for (int i = 0; i < 40; i++)
+        seg_list_push_back(list, i);
+
+    int v = seg_list_pop_back(list);
+    ASSERT_EQUALFMT(v, 39, "%d != %d");
+    ASSERT_EQUAL(seg_list_size(list), 39);
+
+    size_t cap = seg_list_capacity(list);
+    seg_list_clear(list);
+    ASSERT_TRUE(seg_list_empty(list));
+    ASSERT_EQUAL(seg_list_capacity(list), cap);
+    ASSERT_TRUE(seg_list__at(list, 0) == NULL);
+
+    seg_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(SegList_Reserve) {
+    seg_list(double) list = seg_list_new(double);
+
+    seg_list_reserve(list, 1000);
+    ASSERT_TRUE(seg_list_capacity(list) >= 1000);
+    ASSERT_EQUAL(seg_list_size(list), 0);
+
+    seg_list_destroy(list);
+    return 0;
+}
+
+#define PRODUCERS 4
+#define PER_PRODUCER 20000
+
+typedef struct {
+    seg_list(long) list;
+    long id;
+} producer_t;
+
+static void *produce(void *arg) {
+    producer_t *p = arg;
+    for (long i = 0; i < PER_PRODUCER; i++) {
+        long v = p->id * PER_PRODUCER + i + 1;
+        seg_list_push_back_concurrent(p->list, v);
+    }
+    return NULL;
+}
+
+static void *check_published(void *arg) {
+    seg_list(long) list = arg;
+    size_t seen = 0;
+    while (seen < PRODUCERS * PER_PRODUCER) {
+        size_t published = seg_list_published(list);
+        if (published == seen)
+            sched_yield();
+        // every published slot must already hold a value, which are never 0
+        for (; seen < published; seen++)
+            if (seg_list_at(list, seen) == 0)
+                return (void *)1;
+    }
+    return NULL;
+}
+
+TEST_CASE(SegList_ConcurrentPush) {
+    seg_list(long) list = seg_list__create(sizeof(long), 4);
+
+    pthread_t reader, threads[PRODUCERS];
+    producer_t producers[PRODUCERS];
+    pthread_create(&reader, NULL, check_published, (void *)list);
+    for (long t = 0; t < PRODUCERS; t++) {
+        producers[t] = (producer_t){ list, t };
+        pthread_create(&threads[t], NULL, produce, &producers[t]);
+    }
+
+    void *reader_failed;
+    for (int t = 0; t < PRODUCERS; t++)
+        pthread_join(threads[t], NULL);
+    pthread_join(reader, &reader_failed);
+    ASSERT_TRUE(reader_failed == NULL);
+
+    ASSERT_EQUAL(seg_list_size(list), PRODUCERS * PER_PRODUCER);
+    ASSERT_EQUAL(seg_list_published(list), PRODUCERS * PER_PRODUCER);
+
+    // every value shows up exactly once, each producer's in the order it pushed them
+    long next[PRODUCERS] = { 0 };
+    for (size_t i = 0; i < seg_list_size(list); i++) {
+        long v = seg_list_at(list, i) - 1;
+        long id = v / PER_PRODUCER;
+        ASSERT_EQUAL(v % PER_PRODUCER, next[id]);
+        next[id]++;
+    }
+
+    // the list carries on as a normal one afterwards
+    long extra = -1;
+    seg_list_push_back(list, extra);
+    ASSERT_EQUAL(seg_list_back(list), -1);
+    ASSERT_EQUAL(seg_list_published(list), PRODUCERS * PER_PRODUCER + 1);
+
+    seg_list_destroy(list);
+    return 0;
+}
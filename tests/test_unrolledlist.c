@@ -0,0 +1,169 @@
+#include <sncl_test.h>
+
+#include <sncl_unrolledlist.h>
+
+#include <stdint.h>
+
+TEST_CASE(UnrolledList_CreateEmpty) {
+    unrolled_list(int64_t) list = unrolled_list_new(int64_t);
+
+    ASSERT_TRUE(unrolled_list_empty(list));
+    ASSERT_EQUAL(unrolled_list_size(list), 0);
+    ASSERT_EQUAL(unrolled_list_node_count(list), 0);
+
+    unrolled_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(UnrolledList_PushBothEnds) {
+    unrolled_list(int) list = unrolled_list__create(sizeof(int), 4);
+
+    for (int i = 0; i < 10; i++)
+        unrolled_list_push_back(list, i);
+    for (int i = -1; i >= -10; i--)
+        unrolled_list_push_front(list, i);
+
+    ASSERT_EQUAL(unrolled_list_size(list), 20);
+    ASSERT_EQUAL(unrolled_list_node_count(list), 6);
+    ASSERT_EQUALFMT(unrolled_list_front(list), -10, "%d != %d");
+    ASSERT_EQUALFMT(unrolled_list_back(list), 9, "%d != %d");
+    for (int i = 0; i < 20; i++)
+        ASSERT_EQUALFMT(unrolled_list_at(list, i), i - 10, "%d != %d");
+
+    unrolled_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(UnrolledList_Iterate) {
+    unrolled_list(int) list = unrolled_list__create(sizeof(int), 3);
+
+    for (int i = 0; i < 11; i++)
+        unrolled_list_push_back(list, i);
+
+    unrolled_list_start(list);
+    for (int i = 0; i < 11; i++)
+        ASSERT_EQUALFMT(unrolled_list_next(list), i, "%d != %d");
+    ASSERT_TRUE(unrolled_list__next(list) == NULL);
+
+    unrolled_list_rstart(list);
+    for (int i = 10; i >= 0; i--)
+        ASSERT_EQUALFMT(unrolled_list_next(list), i, "%d != %d");
+    ASSERT_TRUE(unrolled_list__next(list) == NULL);
+
+    unrolled_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(UnrolledList_AddSplits) {
+    unrolled_list(int) list = unrolled_list__create(sizeof(int), 4);
+
+    for (int i = 0; i < 4; i++) {
+        int v = i * 10;
+        unrolled_list_push_back(list, v);
+    }
+    ASSERT_EQUAL(unrolled_list_node_count(list), 1);
+
+    int v = 15;
+    unrolled_list_add(list, 2, v);
+    ASSERT_EQUAL(unrolled_list_node_count(list), 2);
+
+    v = 5;
+    unrolled_list_add(list, 1, v);
+    v = 35;
+    unrolled_list_add(list, 6, v);
+
+    int expected[] = { 0, 5, 10, 15, 20, 30, 35 };
+    ASSERT_EQUAL(unrolled_list_size(list), 7);
+    for (int i = 0; i < 7; i++)
+        ASSERT_EQUALFMT(unrolled_list_at(list, i), expected[i], "%d != %d");
+
+    unrolled_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(UnrolledList_RemoveMerges) {
+    unrolled_list(int) list = unrolled_list__create(sizeof(int), 8);
+
+    for (int i = 0; i < 64; i++)
+        unrolled_list_push_back(list, i);
+    ASSERT_EQUAL(unrolled_list_node_count(list), 8);
+
+    // dropping every odd element leaves each node exactly half full, which is still left alone
+    for (int i = 63; i > 0; i -= 2) {
+        int v = unrolled_list_remove(list, (size_t)i);
+        ASSERT_EQUALFMT(v, i, "%d != %d");
+    }
+    ASSERT_EQUAL(unrolled_list_size(list), 32);
+    ASSERT_EQUAL(unrolled_list_node_count(list), 8);
+
+    // one more removal drops the first node below half, merging its neighbour into it
+    unrolled_list__remove(list, 0);
+    ASSERT_EQUAL(unrolled_list_node_count(list), 7);
+    for (int i = 0; i < 31; i++)
+        ASSERT_EQUALFMT(unrolled_list_at(list, i), i * 2 + 2, "%d != %d");
+
+    unrolled_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(UnrolledList_PopBothEnds) {
+    unrolled_list(int) list = unrolled_list__create(sizeof(int), 4);
+
+    for (int i = 0; i < 9; i++)
+        unrolled_list_push_back(list, i);
+
+    for (int i = 0; i < 4; i++) {
+        int front = unrolled_list_pop_front(list);
+        int back = unrolled_list_pop_back(list);
+        ASSERT_EQUALFMT(front, i, "%d != %d");
+        ASSERT_EQUALFMT(back, 8 - i, "%d != %d");
+    }
+
+    ASSERT_EQUAL(unrolled_list_size(list), 1);
+    ASSERT_EQUALFMT(unrolled_list_front(list), 4, "%d != %d");
+    unrolled_list__pop_back(list);
+    ASSERT_TRUE(unrolled_list_empty(list));
+    ASSERT_EQUAL(unrolled_list_node_count(list), 0);
+
+    unrolled_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(UnrolledList_MatchesReference) {
+    unrolled_list(int) list = unrolled_list__create(sizeof(int), 5);
+    int reference[600];
+    size_t size = 0;
+
+    uint32_t seed = 11;
+    for (int step = 0; step < 3000; step++) {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t r = seed >> 8;
+
+        if (size < 600 && (r % 3 != 0 || size == 0)) {
+            size_t pos = (r >> 4) % (size + 1);
+            int v = step;
+            unrolled_list_add(list, pos, v);
+            memmove(&reference[pos + 1], &reference[pos], (size - pos) * sizeof(int));
+            reference[pos] = v;
+            size++;
+        } else {
+            size_t pos = (r >> 4) % size;
+            unrolled_list__remove(list, pos);
+            memmove(&reference[pos], &reference[pos + 1], (size - pos - 1) * sizeof(int));
+            size--;
+        }
+    }
+
+    ASSERT_EQUAL(unrolled_list_size(list), size);
+    unrolled_list_start(list);
+    for (size_t i = 0; i < size; i++) {
+        ASSERT_EQUALFMT(unrolled_list_at(list, i), reference[i], "%d != %d");
+        ASSERT_EQUALFMT(unrolled_list_next(list), reference[i], "%d != %d");
+    }
+
+    unrolled_list_clear(list);
+    ASSERT_TRUE(unrolled_list_empty(list));
+
+    unrolled_list_destroy(list);
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <sncl_test.h>
+
+#include <sncl_xorlist.h>
+
+#include <stdint.h>
+
+TEST_CASE(XorList_CreateEmpty) {
+    xor_list(int64_t) list = xor_list_new(int64_t);
+
+    ASSERT_TRUE(xor_list_empty(list));
+    ASSERT_EQUAL(xor_list_size(list), 0);
+
+    xor_list_iter_t it = xor_list_begin(list);
+    ASSERT_TRUE(xor_list_iter_at(list, &it) == NULL);
+
+    xor_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(XorList_PushPopBothEnds) {
+    xor_list(int64_t) list = xor_list_new(int64_t);
+
+    for (int64_t i = 0; i < 100; i++)
+        xor_list_push_back(list, i);
+    for (int64_t i = -1; i >= -100; i--)
+        xor_list_push_front(list, i);
+
+    ASSERT_EQUAL(xor_list_size(list), 200);
+    ASSERT_EQUAL(xor_list_front(list), -100);
+    ASSERT_EQUAL(xor_list_back(list), 99);
+
+    for (int64_t i = 0; i < 100; i++) {
+        int64_t front = xor_list_pop_front(list);
+        int64_t back = xor_list_pop_back(list);
+        ASSERT_EQUAL(front, i - 100);
+        ASSERT_EQUAL(back, 99 - i);
+    }
+    ASSERT_TRUE(xor_list_empty(list));
+
+    xor_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(XorList_IterateBothWays) {
+    xor_list(int) list = xor_list_new(int);
+
+    for (int i = 0; i < 500; i++)
+        xor_list_push_back(list, i);
+
+    int expected = 0;
+    for (xor_list_iter_t it = xor_list_begin(list); xor_list_iter_at(list, &it); xor_list_iter_next(list, &it)) {
+        ASSERT_EQUALFMT(*xor_list_iter_at(list, &it), expected, "%d != %d");
+        expected++;
+    }
+    ASSERT_EQUALFMT(expected, 500, "%d != %d");
+
+    // two iterators walking the list at once
+    xor_list_iter_t fwd = xor_list_begin(list), rev = xor_list_rbegin(list);
+    for (int i = 0; i < 500; i++) {
+        ASSERT_EQUALFMT(*xor_list_iter_at(list, &fwd), i, "%d != %d");
+        ASSERT_EQUALFMT(*xor_list_iter_at(list, &rev), 499 - i, "%d != %d");
+        xor_list_iter_next(list, &fwd);
+        xor_list_iter_next(list, &rev);
+    }
+    ASSERT_TRUE(xor_list_iter_at(list, &fwd) == NULL);
+    ASSERT_TRUE(xor_list_iter_at(list, &rev) == NULL);
+
+    // stepping past the end stays there
+    xor_list_iter_next(list, &fwd);
+    ASSERT_TRUE(xor_list_iter_at(list, &fwd) == NULL);
+
+    xor_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(XorList_IterRemove) {
+    xor_list(int) list = xor_list_new(int);
+
+    for (int i = 0; i < 20; i++)
+        xor_list_push_back(list, i);
+
+    // drop multiples of 3 going forwards, which takes out the first element
+    for (xor_list_iter_t it = xor_list_begin(list); xor_list_iter_at(list, &it);) {
+        if (*xor_list_iter_at(list, &it) % 3 == 0)
+            xor_list_iter_remove(list, &it);
+        else
+            xor_list_iter_next(list, &it);
+    }
+
+    // drop odd elements going backwards, which takes out the last element
+    for (xor_list_iter_t it = xor_list_rbegin(list); xor_list_iter_at(list, &it);) {
+        if (*xor_list_iter_at(list, &it) % 2)
+            xor_list_iter_remove(list, &it);
+        else
+            xor_list_iter_next(list, &it);
+    }
+
+    int expected[] = { 2, 4, 8, 10, 14, 16 };
+    ASSERT_EQUAL(xor_list_size(list), 6);
+    ASSERT_EQUALFMT(xor_list_front(list), 2, "%d != %d");
+    ASSERT_EQUALFMT(xor_list_back(list), 16, "%d != %d");
+
+    xor_list_iter_t rev = xor_list_rbegin(list);
+    for (int i = 5; i >= 0; i--) {
+        ASSERT_EQUALFMT(*xor_list_iter_at(list, &rev), expected[i], "%d != %d");
+        xor_list_iter_next(list, &rev);
+    }
+
+    // removed nodes are reused before new ones are carved
+    size_t before = xor_list_memory_usage(list);
+    for (int i = 0; i < 14; i++)
+        xor_list_push_front(list, i);
+    ASSERT_EQUAL(xor_list_memory_usage(list), before);
+
+    xor_list_destroy(list);
+    return 0;
+}
+
+TEST_CASE(XorList_MemoryFootprint) {
+    xor_list(int64_t) list = xor_list_new(int64_t);
+
+    // exactly fills slabs of 64, 128, ... 65536 nodes
+    const int64_t count = 131008;
+    for (int64_t i = 0; i < count; i++)
+        xor_list_push_back(list, i);
+
+    // one link and the payload per node, plus a header per slab
+    ASSERT_TRUE(xor_list_memory_usage(list) < (size_t)count * 16 + 1024);
+
+    xor_list_clear(list);
+    ASSERT_TRUE(xor_list_empty(list));
+    size_t before = xor_list_memory_usage(list);
+    for (int64_t i = 0; i < count; i++)
+        xor_list_push_front(list, i);
+    ASSERT_EQUAL(xor_list_memory_usage(list), before);
+    ASSERT_EQUAL(xor_list_back(list), 0);
+
+    xor_list_destroy(list);
+    return 0;
+}